@@ -0,0 +1,510 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <bytecode/batch_evaluator.h>
+#include <bytecode/batch_kernels.h>
+#include <bytecode/gradient_evaluator.h>
+#include <bytecode/incremental_evaluator.h>
+#include <bytecode/parallel_evaluator.h>
+#include <bytecode/sweep_evaluator.h>
+#include <bytecode/tiered_program.h>
+#include <jit/jit_operation.h>
+#include <parser/caching_expression_parser.h>
+#include <parser/linear_expression_parser.h>
+#include <parser/simple_expression_parser.h>
+#include <parser/static_expression_parser.h>
+#include <random>
+#include <string>
+#include <vector>
+
+// usage: calculator_bench [--benchmark_filter=<regex>] [--benchmark_out=<file> --benchmark_out_format=json]
+// results of two commits can be compared by `compare.py benchmarks <old.json> <new.json>` of Google Benchmark
+
+namespace {
+
+    using BigDecimal = boost::multiprecision::cpp_rational;
+
+    /*
+     * Corpus
+     */
+
+    enum Corpus : int64_t { SHORT, NESTED, WIDE, TRIGONOMETRIC, CORPORA };
+
+    char const* const CORPUS_NAMES[] = {"short", "nested", "wide", "trigonometric"};
+
+    std::string nested(size_t const depth) {
+        std::string expression = "x";
+        for (size_t level = 0; level < depth; ++level)
+            expression = '(' + expression + (level % 2 == 0 ? " + " : " * ") + std::to_string(level % 7 + 1) + ')';
+
+        return expression;
+    }
+
+    std::string wide(size_t const terms) {
+        std::string expression = "x";
+        for (size_t term = 1; term < terms; ++term)
+            expression += (term % 3 == 0 ? " - " : " + ") + std::to_string(term) + (term % 2 == 0 ? "*x" : "*y");
+
+        return expression;
+    }
+
+    std::string trigonometric(size_t const terms) {
+        static char const* const FUNCTIONS[] = {"sin", "cos", "tg", "ctg"};
+
+        std::string expression = "sin(x)";
+        for (size_t term = 1; term < terms; ++term)
+            expression += std::string(term % 2 == 0 ? " + " : " * ") + FUNCTIONS[term % 4] + "(x/"
+                          + std::to_string(term) + " + y)";
+
+        return expression;
+    }
+
+    std::vector<std::string> const& corpus(int64_t const corpus) {
+        static std::vector<std::string> const corpora[] = {
+            {"2 + 2 * 2", "x^2 + 3*x - 7", "(x + y) / (x - y)", "sqrt(x*x + y*y)", "-x + 1/y"},
+            {nested(16), nested(64), nested(256)},
+            {wide(64), wide(256), wide(1024)},
+            {trigonometric(4), trigonometric(16), "sin(x)^2 + cos(x)^2 - tg(y)*ctg(y)",
+             "sin x * cos y + tg x - ctg y"}};
+
+        return corpora[corpus];
+    }
+
+    template<typename T>
+    Variables<T> variables() {
+        Variables<T> variables;
+        variables.set('x', T(3) / T(7));
+        variables.set('y', T(5) / T(11));
+
+        return variables;
+    }
+
+    template<typename T>
+    std::vector<std::shared_ptr<calculator::Operation<T>>> parsed(int64_t const corpus) {
+        calculator::LinearExpressionParser<T> parser;
+        std::vector<std::shared_ptr<calculator::Operation<T>>> operations;
+        for (auto const& expression : ::corpus(corpus))
+            operations.push_back(parser.parse(std::string_view(expression)));
+
+        return operations;
+    }
+
+    void corpusArguments(benchmark::internal::Benchmark* const benchmark) {
+        benchmark->ArgName("corpus");
+        for (int64_t corpus = 0; corpus < CORPORA; ++corpus) benchmark->Arg(corpus);
+    }
+
+    void labelCorpus(benchmark::State& state) { state.SetLabel(CORPUS_NAMES[state.range(0)]); }
+
+    /*
+     * Parsing
+     */
+
+    // the expressions of the corpus which the parser accepts as the simple parser does not accept some forms
+    template<typename Parser>
+    std::vector<std::string> accepted(Parser& parser, std::vector<std::string> const& expressions) {
+        std::vector<std::string> accepted;
+        for (auto const& expression : expressions) try {
+                parser.parse(std::string_view(expression));
+                accepted.push_back(expression);
+            } catch (...) {}
+
+        return accepted;
+    }
+
+    template<typename Parser>
+    void parse(benchmark::State& state) {
+        Parser parser;
+        auto const expressions = accepted(parser, corpus(state.range(0)));
+        if (expressions.empty()) return state.SkipWithError("No expression of the corpus is accepted");
+        size_t bytes = 0;
+        for (auto _ : state)
+            for (auto const& expression : expressions) {
+                benchmark::DoNotOptimize(parser.parse(std::string_view(expression)));
+                bytes += expression.size();
+            }
+        state.SetBytesProcessed(int64_t(bytes));
+        state.SetLabel(std::string(CORPUS_NAMES[state.range(0)]) + ' ' + std::to_string(expressions.size()) + '/'
+                       + std::to_string(corpus(state.range(0)).size()));
+    }
+
+    BENCHMARK_TEMPLATE(parse, calculator::SimpleOperationParser<double>)->Apply(corpusArguments);
+    BENCHMARK_TEMPLATE(parse, calculator::LinearExpressionParser<double>)->Apply(corpusArguments);
+
+    void parseCached(benchmark::State& state) {
+        calculator::CachingExpressionParser<double> parser(
+                std::make_shared<calculator::LinearExpressionParser<double>>());
+        auto const& expressions = corpus(state.range(0));
+        size_t bytes = 0;
+        for (auto _ : state)
+            for (auto const& expression : expressions) {
+                benchmark::DoNotOptimize(parser.parse(std::string_view(expression)));
+                bytes += expression.size();
+            }
+        state.SetBytesProcessed(int64_t(bytes));
+        labelCorpus(state);
+    }
+
+    BENCHMARK(parseCached)->Apply(corpusArguments);
+
+    /*
+     * Evaluation
+     */
+
+    template<typename T>
+    void result(benchmark::State& state) {
+        auto const operations = parsed<T>(state.range(0));
+        auto const values = variables<T>();
+        for (auto _ : state)
+            for (auto const& operation : operations) benchmark::DoNotOptimize(operation->result(values));
+        state.SetItemsProcessed(int64_t(state.iterations() * operations.size()));
+        labelCorpus(state);
+    }
+
+    BENCHMARK_TEMPLATE(result, double)->Apply(corpusArguments);
+    BENCHMARK_TEMPLATE(result, BigDecimal)->Apply(corpusArguments);
+
+    template<typename T>
+    void programResult(benchmark::State& state) {
+        std::vector<calculator::Program<T>> programs;
+        for (auto const& operation : parsed<T>(state.range(0))) programs.push_back(calculator::compile(*operation));
+        auto const values = variables<T>();
+        for (auto _ : state)
+            for (auto const& program : programs) benchmark::DoNotOptimize(program.result(values));
+        state.SetItemsProcessed(int64_t(state.iterations() * programs.size()));
+        labelCorpus(state);
+    }
+
+    BENCHMARK_TEMPLATE(programResult, double)->Apply(corpusArguments);
+    BENCHMARK_TEMPLATE(programResult, BigDecimal)->Apply(corpusArguments);
+
+    void nativeResult(benchmark::State& state) {
+        std::vector<calculator::NativeFunction> functions;
+        calculator::NativeCompiler const compiler;
+        for (auto const& operation : parsed<double>(state.range(0)))
+            functions.push_back(compiler.compile(calculator::compile(*operation)));
+        auto const values = variables<double>();
+        for (auto _ : state)
+            for (auto const& function : functions) benchmark::DoNotOptimize(function.result(values));
+        state.SetItemsProcessed(int64_t(state.iterations() * functions.size()));
+        labelCorpus(state);
+    }
+
+    BENCHMARK(nativeResult)->Apply(corpusArguments);
+
+    // the cost of a tier-up of a JIT operation, the compiler runs in another process so the real time is measured
+    void nativeCompile(benchmark::State& state) {
+        std::vector<calculator::Program<double>> programs;
+        for (auto const& operation : parsed<double>(state.range(0)))
+            programs.push_back(calculator::compile(*operation));
+        calculator::NativeCompiler const compiler;
+        for (auto _ : state)
+            for (auto const& program : programs) benchmark::DoNotOptimize(compiler.compile(program));
+        state.SetItemsProcessed(int64_t(state.iterations() * programs.size()));
+        labelCorpus(state);
+    }
+
+    BENCHMARK(nativeCompile)->Arg(SHORT)->Arg(WIDE)->ArgName("corpus")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    void tieredResult(benchmark::State& state) {
+        std::vector<calculator::TieredProgram<BigDecimal>> programs;
+        for (auto const& operation : parsed<BigDecimal>(state.range(0)))
+            programs.push_back(calculator::compileTiered(*operation));
+        Variables<BigDecimal> values;
+        values.set('x', 3);
+        values.set('y', 5);
+        for (auto _ : state)
+            for (auto const& program : programs) benchmark::DoNotOptimize(program.result(values));
+        state.SetItemsProcessed(int64_t(state.iterations() * programs.size()));
+        labelCorpus(state);
+    }
+
+    BENCHMARK(tieredResult)->Arg(SHORT)->Arg(NESTED)->Arg(WIDE)->ArgName("corpus");
+
+    void variablesLookup(benchmark::State& state) {
+        auto const values = variables<double>();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(values.find(Variables<double>::slotOf('x')));
+            benchmark::DoNotOptimize(values.get('y'));
+            benchmark::DoNotOptimize(values.get('z'));
+        }
+        state.SetItemsProcessed(int64_t(state.iterations() * 3));
+    }
+
+    BENCHMARK(variablesLookup);
+
+    /*
+     * Expressions known at compile time
+     */
+
+    constexpr calculator::FixedString POLYNOMIAL = "3*x^3 - 2*x^2 + x/7 - 1";
+    constexpr calculator::FixedString FRACTION = "(x + y) / (x - y) * (x*y + 1) / (y^2 + 1)";
+    constexpr calculator::FixedString TRIGONOMETRY = "sin(x)^2 + cos(x*y) - tg(x/3)";
+
+    template<calculator::FixedString EXPRESSION, typename T>
+    void staticExpression(benchmark::State& state) {
+        auto const values = variables<T>();
+        for (auto _ : state)
+            benchmark::DoNotOptimize(calculator::StaticExpression<EXPRESSION>::template result<T>(values));
+        state.SetItemsProcessed(int64_t(state.iterations()));
+    }
+
+    // the same expression parsed at run time for a comparison with `staticExpression`
+    template<calculator::FixedString EXPRESSION, typename T>
+    void parsedExpression(benchmark::State& state) {
+        auto const operation = calculator::LinearExpressionParser<T>().parse(EXPRESSION.view());
+        auto const values = variables<T>();
+        for (auto _ : state) benchmark::DoNotOptimize(operation->result(values));
+        state.SetItemsProcessed(int64_t(state.iterations()));
+    }
+
+    BENCHMARK_TEMPLATE(staticExpression, POLYNOMIAL, double);
+    BENCHMARK_TEMPLATE(parsedExpression, POLYNOMIAL, double);
+    BENCHMARK_TEMPLATE(staticExpression, FRACTION, double);
+    BENCHMARK_TEMPLATE(parsedExpression, FRACTION, double);
+    BENCHMARK_TEMPLATE(staticExpression, TRIGONOMETRY, double);
+    BENCHMARK_TEMPLATE(parsedExpression, TRIGONOMETRY, double);
+    BENCHMARK_TEMPLATE(staticExpression, POLYNOMIAL, BigDecimal);
+    BENCHMARK_TEMPLATE(parsedExpression, POLYNOMIAL, BigDecimal);
+    BENCHMARK_TEMPLATE(staticExpression, FRACTION, BigDecimal);
+    BENCHMARK_TEMPLATE(parsedExpression, FRACTION, BigDecimal);
+
+    /*
+     * Double-precision kernels
+     */
+
+    enum Kernel : int64_t { SIN, COS, TG, CTG, SQRT, POW, DIVIDE };
+
+    char const* const KERNEL_NAMES[] = {"sin", "cos", "tg", "ctg", "sqrt", "pow", "divide"};
+
+    // maximal distances in ulps from the results of the scalar operations, the same as in double_kernels_test.cpp
+    constexpr uint64_t KERNEL_ULPS[] = {1, 1, 3, 3, 0, 2, 0};
+
+    constexpr size_t KERNEL_VALUES = 4096;
+
+    struct KernelArguments {
+        std::vector<double> left, right;
+    };
+
+    // random arguments with a few ones for which the kernels fall back to the scalar operations
+    KernelArguments kernelArguments(int64_t const kernel) {
+        std::mt19937_64 random(42);
+        KernelArguments arguments{std::vector<double>(KERNEL_VALUES), std::vector<double>(KERNEL_VALUES)};
+        for (size_t i = 0; i < KERNEL_VALUES; ++i) {
+            switch (kernel) {
+                case SQRT: arguments.left[i] = std::uniform_real_distribution(0., 1e6)(random); break;
+                case POW: {
+                    arguments.left[i] = std::uniform_real_distribution(1e-3, 1e2)(random);
+                    arguments.right[i] = std::uniform_real_distribution(-4., 4.)(random);
+                    break;
+                }
+                case DIVIDE: {
+                    arguments.left[i] = std::uniform_real_distribution(-1e3, 1e3)(random);
+                    arguments.right[i] = std::uniform_real_distribution(1., 1e3)(random);
+                    break;
+                }
+                default: arguments.left[i] = std::uniform_real_distribution(-10., 10.)(random);
+            }
+        }
+        arguments.left[0] = kernel == POW ? M_E : 1e6;
+        arguments.right[1] = arguments.right[2] = kernel == POW ? 2. : 1.;
+        arguments.right[3] = kernel == POW ? 3. : 1.;
+
+        return arguments;
+    }
+
+    template<typename K>
+    void applyKernel(int64_t const kernel, double* const left, double const* const right) {
+        switch (kernel) {
+            case SIN: return K::sin(left, KERNEL_VALUES);
+            case COS: return K::cos(left, KERNEL_VALUES);
+            case TG: return K::tg(left, KERNEL_VALUES);
+            case CTG: return K::ctg(left, KERNEL_VALUES);
+            case SQRT: return K::sqrt(left, KERNEL_VALUES);
+            case POW: return K::pow(left, right, KERNEL_VALUES);
+            default: return K::divide(left, right, KERNEL_VALUES);
+        }
+    }
+
+    uint64_t ulps(double const left, double const right) {
+        if (std::isnan(left) || std::isnan(right)) return std::isnan(left) && std::isnan(right) ? 0 : UINT64_MAX;
+
+        // the order of the bits of doubles made monotonic
+        auto const ordered = [](double const value) {
+            int64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits < 0 ? INT64_MIN - bits : bits;
+        };
+        auto const difference = ordered(left) - ordered(right);
+
+        return difference < 0 ? 0 - uint64_t(difference) : uint64_t(difference);
+    }
+
+    // values per second of a kernel with the instruction set of the argument,
+    // it fails if the results are farther from those of the scalar operations than `KERNEL_ULPS`
+    void doubleKernel(benchmark::State& state) {
+        auto const kernel = state.range(0);
+        auto const instructionSet = calculator::InstructionSet(state.range(1));
+        if (instructionSet > calculator::SimdDoubleKernels::supportedInstructionSet())
+            return state.SkipWithError("The instruction set is not supported");
+
+        auto const arguments = kernelArguments(kernel);
+        auto expected = arguments.left, values = arguments.left;
+        applyKernel<calculator::ScalarBatchKernels<double>>(kernel, expected.data(), arguments.right.data());
+        calculator::SimdDoubleKernels::useInstructionSet(instructionSet);
+        applyKernel<calculator::BatchKernels<double>>(kernel, values.data(), arguments.right.data());
+        uint64_t maxUlps = 0;
+        for (size_t i = 0; i < KERNEL_VALUES; ++i) maxUlps = std::max(maxUlps, ulps(values[i], expected[i]));
+        state.counters["max_ulps"] = double(maxUlps);
+
+        if (maxUlps > KERNEL_ULPS[kernel]) state.SkipWithError("The results are not accurate");
+        else
+            for (auto _ : state) {
+                std::copy(arguments.left.begin(), arguments.left.end(), values.begin());
+                applyKernel<calculator::BatchKernels<double>>(kernel, values.data(), arguments.right.data());
+                benchmark::DoNotOptimize(values.data());
+            }
+        calculator::SimdDoubleKernels::useInstructionSet(calculator::SimdDoubleKernels::supportedInstructionSet());
+        state.SetItemsProcessed(int64_t(state.iterations() * KERNEL_VALUES));
+        state.SetLabel(std::string(KERNEL_NAMES[kernel]) + ' '
+                       + (instructionSet == calculator::InstructionSet::AVX2   ? "avx2"
+                          : instructionSet == calculator::InstructionSet::SSE2 ? "sse2"
+                                                                               : "scalar"));
+    }
+
+    BENCHMARK(doubleKernel)
+            ->ArgsProduct({{SIN, COS, TG, CTG, SQRT, POW, DIVIDE},
+                           {int64_t(calculator::InstructionSet::SCALAR), int64_t(calculator::InstructionSet::SSE2),
+                            int64_t(calculator::InstructionSet::AVX2)}})
+            ->ArgNames({"kernel", "instructions"});
+
+    /*
+     * Evaluation over many bindings of the variables
+     */
+
+    constexpr size_t ROWS = 1 << 14;
+
+    void batchEvaluate(benchmark::State& state) {
+        auto const program = calculator::compile(*parsed<double>(state.range(0)).back());
+        std::vector<double> xs(ROWS), ys(ROWS), results(ROWS);
+        for (size_t row = 0; row < ROWS; ++row) {
+            xs[row] = double(row) / ROWS;
+            ys[row] = 1 + double(row % 97) / 97;
+        }
+        calculator::VariableColumns<double> const columns{{'x', xs}, {'y', ys}};
+        calculator::BatchEvaluator<double> evaluator(program);
+        for (auto _ : state) {
+            evaluator.evaluate(columns, results);
+            benchmark::DoNotOptimize(results.data());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations() * ROWS));
+        labelCorpus(state);
+    }
+
+    BENCHMARK(batchEvaluate)->Apply(corpusArguments);
+
+    template<typename T>
+    void parallelEvaluate(benchmark::State& state) {
+        auto const rows = std::is_floating_point_v<T> ? ROWS : ROWS / 16;
+        auto const program = calculator::compile(*parsed<T>(WIDE)[1]);
+        std::vector<Variables<T>> bindings(rows);
+        for (size_t row = 0; row < rows; ++row) {
+            bindings[row].set('x', T(int64_t(row)) / T(rows));
+            bindings[row].set('y', T(int64_t(row % 97)));
+        }
+        std::vector<T> results(rows);
+        calculator::ThreadPool pool(size_t(state.range(0)));
+        for (auto _ : state) calculator::evaluateParallel<T>(program, bindings, results, pool);
+        state.SetItemsProcessed(int64_t(state.iterations() * rows));
+    }
+
+    void threadArguments(benchmark::internal::Benchmark* const benchmark) {
+        benchmark->ArgName("threads")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+    }
+
+    BENCHMARK_TEMPLATE(parallelEvaluate, double)->Apply(threadArguments);
+    BENCHMARK_TEMPLATE(parallelEvaluate, BigDecimal)->Apply(threadArguments);
+
+    template<typename T>
+    void incrementalUpdate(benchmark::State& state) {
+        calculator::IncrementalEvaluator<T> evaluator(*parsed<T>(WIDE).back(), variables<T>());
+        int64_t value = 0;
+        for (auto _ : state) {
+            evaluator.setVariable('x', T(++value % 101));
+            benchmark::DoNotOptimize(evaluator.result());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()));
+    }
+
+    BENCHMARK_TEMPLATE(incrementalUpdate, double);
+    BENCHMARK_TEMPLATE(incrementalUpdate, BigDecimal);
+
+    constexpr size_t POINTS = 4096;
+
+    template<calculator::SweepPrecision PRECISION>
+    void sweep(benchmark::State& state) {
+        auto const operation = parsed<double>(state.range(0)).back();
+        calculator::SweepEvaluator<double> evaluator(*operation, 'x', PRECISION);
+        for (auto _ : state) benchmark::DoNotOptimize(evaluator.sweep(0.0, 1.0 / POINTS, POINTS, variables<double>()));
+        state.SetItemsProcessed(int64_t(state.iterations() * POINTS));
+        labelCorpus(state);
+    }
+
+    BENCHMARK_TEMPLATE(sweep, calculator::SweepPrecision::EXACT)->Apply(corpusArguments);
+    BENCHMARK_TEMPLATE(sweep, calculator::SweepPrecision::APPROXIMATE)->Apply(corpusArguments);
+
+    // the same points evaluated one by one for a comparison with `sweep`
+    void pointwise(benchmark::State& state) {
+        auto const program = calculator::compile(*parsed<double>(state.range(0)).back());
+        auto values = variables<double>();
+        for (auto _ : state)
+            for (size_t point = 0; point < POINTS; ++point) {
+                values.set('x', double(point) / POINTS);
+                benchmark::DoNotOptimize(program.result(values));
+            }
+        state.SetItemsProcessed(int64_t(state.iterations() * POINTS));
+        labelCorpus(state);
+    }
+
+    BENCHMARK(pointwise)->Apply(corpusArguments);
+
+    template<typename T>
+    void gradient(benchmark::State& state) {
+        std::vector<calculator::GradientEvaluator<T>> evaluators;
+        for (auto const& operation : parsed<T>(state.range(0))) evaluators.emplace_back(*operation);
+        auto const values = variables<T>();
+        for (auto _ : state)
+            for (auto const& evaluator : evaluators) benchmark::DoNotOptimize(evaluator.gradient(values));
+        state.SetItemsProcessed(int64_t(state.iterations() * evaluators.size()));
+        labelCorpus(state);
+    }
+
+    BENCHMARK_TEMPLATE(gradient, double)->Apply(corpusArguments);
+    BENCHMARK_TEMPLATE(gradient, BigDecimal)->Apply(corpusArguments);
+
+    // the value and central differences by `x` and `y` for a comparison with `gradient`
+    void finiteDifferences(benchmark::State& state) {
+        std::vector<calculator::Program<double>> programs;
+        for (auto const& operation : parsed<double>(state.range(0)))
+            programs.push_back(calculator::compile(*operation));
+        auto const values = variables<double>();
+        constexpr double STEP = 1e-6;
+        for (auto _ : state)
+            for (auto const& program : programs) {
+                benchmark::DoNotOptimize(program.result(values));
+                for (auto const variable : {'x', 'y'}) {
+                    auto shifted = values;
+                    shifted.set(variable, *values.get(variable) + STEP);
+                    auto const forward = program.result(shifted);
+                    shifted.set(variable, *values.get(variable) - STEP);
+                    benchmark::DoNotOptimize((forward - program.result(shifted)) / (2 * STEP));
+                }
+            }
+        state.SetItemsProcessed(int64_t(state.iterations() * programs.size()));
+        labelCorpus(state);
+    }
+
+    BENCHMARK(finiteDifferences)->Apply(corpusArguments);
+} // namespace
+
+BENCHMARK_MAIN();
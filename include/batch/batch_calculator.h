@@ -0,0 +1,182 @@
+#ifndef INCLUDE_BATCH_CALCULATOR_H_
+#define INCLUDE_BATCH_CALCULATOR_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <parser/caching_expression_parser.h>
+#include <parser/linear_expression_parser.h>
+#include <parser/number_literal.h>
+#include <parser/parallelizing_expression_parser.h>
+#include <parser/tiering_expression_parser.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Calculator of expression records of form `expression;name=value;name=value...`, one per line.
+     *
+     * For each non-empty record a line with its result or with `error: <message>` is written.
+     * Expressions are parsed (and, for exact types, compiled into tiered programs) once
+     * and shared by all the records in which they repeat.
+     *
+     * @tparam T result of the calculated expressions
+     */
+    template<typename T>
+    class BatchCalculator final {
+        CachingExpressionParser<T> parser_{makeParser()};
+        LinearExpressionParser<T> valueParser_; // values are not cached as they would evict the expressions
+        Variables<T> variables_, noVariables_;
+        std::string output_;
+
+        static constexpr char SEPARATOR = ';';
+
+        static std::string_view trim(std::string_view text) noexcept {
+            auto const isBlank = [](char const character) {
+                return character == ' ' || character == '\t' || character == '\r';
+            };
+            while (!text.empty() && isBlank(text.front())) text.remove_prefix(1);
+            while (!text.empty() && isBlank(text.back())) text.remove_suffix(1);
+
+            return text;
+        }
+
+        void bind(std::string_view binding) {
+            auto const equals = binding.find('=');
+            if (equals == std::string_view::npos)
+                throw InvalidExpression("Invalid variable binding `" + std::string(binding) + '`');
+
+            auto const name = trim(binding.substr(0, equals));
+            if (name.size() != 1) throw InvalidExpression("Invalid variable name `" + std::string(name) + '`');
+            auto const value = trim(binding.substr(equals + 1));
+
+            // a value which is not a plain number (`-1/3`, `pi/2` etc.) is a constant expression
+            variables_.set(name.front(), isNumberLiteral(value) ? parseNumberLiteral<T>(value)
+                                                                : valueParser_.parse(value)->result(noVariables_));
+        }
+
+        // exact types are evaluated with integers first as most of the records are integer ones,
+        // the tiered programs (which make the wide sums parallel themselves) are cached together with the operations
+        static std::shared_ptr<ExpressionParser<T>> makeParser() {
+            auto parser = std::make_shared<LinearExpressionParser<T>>();
+            if constexpr (std::is_floating_point_v<T>)
+                return std::make_shared<ParallelizingExpressionParser<T>>(std::move(parser));
+            else return std::make_shared<TieringExpressionParser<T>>(std::move(parser));
+        }
+
+        void write(T const& value) {
+            if constexpr (std::is_floating_point_v<T>) {
+                char buffer[32];
+                auto const end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+                output_.append(buffer, end);
+            } else
+                output_ += value.str();
+        }
+
+    public:
+        static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+        /**
+         * @brief Calculates the given record appending the line with its result to the output.
+         */
+        void calculate(std::string_view const record) {
+            auto const end = record.find(SEPARATOR);
+            try {
+                variables_.clear();
+                for (auto begin = end; begin != std::string_view::npos;) {
+                    auto const next = record.find(SEPARATOR, begin + 1);
+                    auto const binding = trim(record.substr(begin + 1, next - begin - 1));
+                    if (!binding.empty()) bind(binding);
+                    begin = next;
+                }
+
+                write(parser_.parse(record.substr(0, end))->result(variables_));
+            } catch (std::exception const& e) {
+                output_ += "error: ";
+                output_ += e.what();
+            }
+            output_ += '\n';
+        }
+
+        /**
+         * @brief Calculates the given records appending the lines with their results to the output.
+         *
+         * @param records records each one of which ends with a line feed (except for, maybe, the last one)
+         */
+        void calculateAll(std::string_view records) {
+            while (!records.empty()) {
+                auto const end = records.find('\n');
+                auto const record = records.substr(0, end);
+                if (!trim(record).empty()) calculate(record);
+                if (end == std::string_view::npos) break;
+                records.remove_prefix(end + 1);
+            }
+        }
+
+        /**
+         * @brief Gets the lines written for the calculated records.
+         */
+        std::string& output() noexcept { return output_; }
+
+        /**
+         * @brief Calculates all the given records writing the results by big chunks.
+         *
+         * The records are read in place so this is the way to calculate a whole mapped file with no copies.
+         *
+         * @param records records each one of which ends with a line feed (except for, maybe, the last one)
+         * @param output file to which the results are written
+         */
+        void calculate(std::string_view records, std::FILE* const output) {
+            while (!records.empty()) {
+                // records up to the next line feed after a chunk
+                auto const end = records.find('\n', std::min(CHUNK_SIZE, records.size()) - 1);
+                auto const size = end == std::string_view::npos ? records.size() : end + 1;
+                calculateAll(records.substr(0, size));
+                records.remove_prefix(size);
+
+                std::fwrite(output_.data(), 1, output_.size(), output);
+                output_.clear();
+            }
+        }
+
+        /**
+         * @brief Calculates all the records of the input reading it by big chunks.
+         *
+         * @param input file from which the records are read
+         * @param output file to which the results are written
+         */
+        void calculate(std::FILE* const input, std::FILE* const output) {
+            std::vector<char> buffer(CHUNK_SIZE);
+            size_t kept = 0; // length of the incomplete last record of the previous chunk
+            size_t read;
+            while ((read = std::fread(buffer.data() + kept, 1, buffer.size() - kept, input)) != 0) {
+                std::string_view const chunk(buffer.data(), kept + read);
+                auto const end = chunk.rfind('\n');
+                if (end == std::string_view::npos) {
+                    // a record longer than the buffer
+                    kept = chunk.size();
+                    if (kept == buffer.size()) buffer.resize(buffer.size() * 2);
+                    continue;
+                }
+
+                calculateAll(chunk.substr(0, end + 1));
+                std::fwrite(output_.data(), 1, output_.size(), output);
+                output_.clear();
+
+                kept = chunk.size() - end - 1;
+                std::copy(chunk.end() - kept, chunk.end(), buffer.begin());
+            }
+
+            calculateAll(std::string_view(buffer.data(), kept));
+            std::fwrite(output_.data(), 1, output_.size(), output);
+            output_.clear();
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_BATCH_CALCULATOR_H_
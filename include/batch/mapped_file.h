@@ -0,0 +1,77 @@
+#ifndef INCLUDE_MAPPED_FILE_H_
+#define INCLUDE_MAPPED_FILE_H_
+
+#include <cerrno>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Read-only file mapped into memory so that its content can be read with no copies.
+     */
+    class MappedFile final {
+        void* data_ = nullptr;
+        size_t size_ = 0;
+
+    public:
+        /**
+         * @brief Maps the given file.
+         *
+         * @param path path to the file
+         * @throws std::system_error if the file can't be mapped
+         */
+        explicit MappedFile(std::string const& path) {
+            auto const descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (descriptor < 0) throw std::system_error(errno, std::generic_category(), "Unable to open " + path);
+
+            struct stat status {};
+            if (::fstat(descriptor, &status) != 0) {
+                auto const error = errno;
+                ::close(descriptor);
+                throw std::system_error(error, std::generic_category(), "Unable to get the size of " + path);
+            }
+
+            size_ = static_cast<size_t>(status.st_size);
+            if (size_ != 0) {
+                data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (data_ == MAP_FAILED) {
+                    auto const error = errno;
+                    ::close(descriptor);
+                    throw std::system_error(error, std::generic_category(), "Unable to map " + path);
+                }
+                ::madvise(data_, size_, MADV_SEQUENTIAL); // only a hint, its failure changes nothing
+            }
+            ::close(descriptor); // the mapping stays valid
+        }
+
+        MappedFile(MappedFile const&) = delete;
+
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            return *this;
+        }
+
+        ~MappedFile() noexcept {
+            if (data_) ::munmap(data_, size_);
+        }
+
+        std::string_view content() const noexcept {
+            return data_ ? std::string_view(static_cast<char const*>(data_), size_) : std::string_view();
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_MAPPED_FILE_H_
@@ -0,0 +1,187 @@
+#ifndef INCLUDE_BATCH_EVALUATOR_H_
+#define INCLUDE_BATCH_EVALUATOR_H_
+
+#include <algorithm>
+#include <bytecode/batch_kernels.h>
+#include <bytecode/program_compiler.h>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Columns of variable values, the `i`-th element of each column belongs to the `i`-th binding.
+     */
+    template<typename T>
+    using VariableColumns = std::map<char, std::span<T const>>;
+
+    /**
+     * @brief Evaluator of a program over many variable bindings processing them by blocks.
+     *
+     * @tparam T result of the program
+     */
+    template<typename T>
+    class BatchEvaluator final {
+        Program<T> const& program_;
+        std::vector<T> blocks_; // value stack of the program where each value is a whole block
+
+    public:
+        static constexpr size_t BLOCK_SIZE = 256;
+
+        explicit BatchEvaluator(Program<T> const& program)
+            : program_(program), blocks_(program.stackSize() * BLOCK_SIZE) {}
+
+        /**
+         * @brief Evaluates the program for each binding of the variables.
+         *
+         * @param columns values of the variables, each column should have at least `results.size()` values
+         * @param results column to which the results are written
+         */
+        void evaluate(VariableColumns<T> const& columns, std::span<T> const results) {
+            auto const count = results.size();
+            for (auto const& [name, column] : columns)
+                if (column.size() < count)
+                    throw OperationError("Column of variable " + std::string(1, name) + " is too short");
+
+            for (size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+                evaluateBlock(columns, begin, std::min(BLOCK_SIZE, count - begin), results.data() + begin);
+        }
+
+    private:
+        void evaluateBlock(VariableColumns<T> const& columns, size_t const begin, size_t const count,
+                           T* const results) {
+            auto const temporaries = blocks_.data();
+            auto top = temporaries + program_.temporaries() * BLOCK_SIZE; // points right after the topmost block
+            auto const& constants = program_.constants();
+            for (auto const& instruction : program_.instructions()) {
+                switch (instruction.code) {
+                    case OpCode::CONSTANT: {
+                        std::fill_n(top, count, constants[instruction.argument]);
+                        top += BLOCK_SIZE;
+                        break;
+                    }
+                    case OpCode::VARIABLE: {
+                        auto const name = Variables<T>::nameOf(instruction.argument);
+                        auto const column = columns.find(name);
+                        if (column == columns.end()) throw OperationError("Unknown variable: " + std::string(1, name));
+                        std::copy_n(column->second.data() + begin, count, top);
+                        top += BLOCK_SIZE;
+                        break;
+                    }
+                    case OpCode::LOAD: {
+                        std::copy_n(temporaries + instruction.argument * BLOCK_SIZE, count, top);
+                        top += BLOCK_SIZE;
+                        break;
+                    }
+                    case OpCode::STORE: {
+                        std::copy_n(top - BLOCK_SIZE, count, temporaries + instruction.argument * BLOCK_SIZE);
+                        break;
+                    }
+                    case OpCode::PLUS: {
+                        top -= BLOCK_SIZE;
+                        BatchKernels<T>::plus(top - BLOCK_SIZE, top, count);
+                        break;
+                    }
+                    case OpCode::NEGATIVE: {
+                        BatchKernels<T>::negative(top - BLOCK_SIZE, count);
+                        break;
+                    }
+                    case OpCode::MINUS: {
+                        top -= BLOCK_SIZE;
+                        BatchKernels<T>::minus(top - BLOCK_SIZE, top, count);
+                        break;
+                    }
+                    case OpCode::MULTIPLY: {
+                        top -= BLOCK_SIZE;
+                        BatchKernels<T>::multiply(top - BLOCK_SIZE, top, count);
+                        break;
+                    }
+                    case OpCode::DIVIDE: {
+                        top -= BLOCK_SIZE;
+                        BatchKernels<T>::divide(top - BLOCK_SIZE, top, count);
+                        break;
+                    }
+                    case OpCode::INVERT: {
+                        BatchKernels<T>::invert(top - BLOCK_SIZE, count);
+                        break;
+                    }
+                    case OpCode::POW: {
+                        top -= BLOCK_SIZE;
+                        BatchKernels<T>::pow(top - BLOCK_SIZE, top, count);
+                        break;
+                    }
+                    case OpCode::SQRT: {
+                        BatchKernels<T>::sqrt(top - BLOCK_SIZE, count);
+                        break;
+                    }
+                    case OpCode::SUM: {
+                        // same order of additions as in VectorSumOperation
+                        auto const operands = instruction.argument;
+                        if (operands == 0) {
+                            std::fill_n(top, count, T{});
+                            top += BLOCK_SIZE;
+                            break;
+                        }
+                        auto const sum = top - operands * BLOCK_SIZE;
+                        if (operands < VectorSumOperation<T>::pairwiseThreshold()) {
+                            for (size_t i = 0; i < count; ++i) sum[i] = T{} + sum[i];
+                            for (auto block = sum + BLOCK_SIZE; block != top; block += BLOCK_SIZE)
+                                BatchKernels<T>::plus(sum, block, count);
+                        } else {
+                            for (size_t stride = 1; stride < operands; stride *= 2)
+                                for (size_t i = 0; i + stride < operands; i += 2 * stride)
+                                    BatchKernels<T>::plus(sum + i * BLOCK_SIZE, sum + (i + stride) * BLOCK_SIZE, count);
+                        }
+                        top = sum + BLOCK_SIZE;
+                        break;
+                    }
+                    case OpCode::SIN: {
+                        BatchKernels<T>::sin(top - BLOCK_SIZE, count);
+                        break;
+                    }
+                    case OpCode::COS: {
+                        BatchKernels<T>::cos(top - BLOCK_SIZE, count);
+                        break;
+                    }
+                    case OpCode::TG: {
+                        BatchKernels<T>::tg(top - BLOCK_SIZE, count);
+                        break;
+                    }
+                    case OpCode::CTG: {
+                        BatchKernels<T>::ctg(top - BLOCK_SIZE, count);
+                        break;
+                    }
+                }
+            }
+
+            auto const result = temporaries + program_.temporaries() * BLOCK_SIZE;
+            std::move(result, result + count, results);
+        }
+    };
+
+    /**
+     * @brief Evaluates the program for each binding of the variables.
+     *
+     * @param columns values of the variables, each column should have at least `results.size()` values
+     * @param results column to which the results are written
+     */
+    template<typename T>
+    void evaluateBatch(Program<T> const& program, VariableColumns<T> const& columns, std::span<T> const results) {
+        BatchEvaluator<T>(program).evaluate(columns, results);
+    }
+
+    /**
+     * @brief Evaluates the operation for each binding of the variables.
+     *
+     * @param columns values of the variables, each column should have at least `results.size()` values
+     * @param results column to which the results are written
+     */
+    template<typename T>
+    void evaluateBatch(Operation<T> const& operation, VariableColumns<T> const& columns, std::span<T> const results) {
+        evaluateBatch(compile(operation), columns, results);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_BATCH_EVALUATOR_H_
@@ -0,0 +1,95 @@
+#ifndef INCLUDE_BATCH_KERNELS_H_
+#define INCLUDE_BATCH_KERNELS_H_
+
+#include <algorithm>
+#include <operation/algebraic_operations.h>
+#include <simd/double_kernels.h>
+
+namespace calculator {
+
+    /**
+     * @brief Kernels applying an operation to whole blocks of values in place one value after another.
+     *
+     * @tparam T type of the values
+     */
+    template<typename T>
+    struct ScalarBatchKernels {
+        template<typename O>
+        static void unary(T* const values, size_t const count) {
+            for (size_t i = 0; i < count; ++i) values[i] = O::compute(values[i]);
+        }
+
+        template<typename O>
+        static void binary(T* const left, T const* const right, size_t const count) {
+            for (size_t i = 0; i < count; ++i) left[i] = O::compute(left[i], right[i]);
+        }
+
+        static void divide(T* const left, T const* const right, size_t const count) {
+            // checking divisors ahead keeps the division loop itself free of branches
+            if (std::find(right, right + count, T{}) != right + count) throw OperationError("Division by zero");
+            for (size_t i = 0; i < count; ++i) left[i] = left[i] / right[i];
+        }
+
+        static void negative(T* const values, size_t const count) { unary<NegativeOperation<T>>(values, count); }
+
+        static void invert(T* const values, size_t const count) { unary<InvertOperation<T>>(values, count); }
+
+        static void sqrt(T* const values, size_t const count) { unary<PrimitiveSqrtOperation<T>>(values, count); }
+
+        static void sin(T* const values, size_t const count) { unary<SinOperation<T>>(values, count); }
+
+        static void cos(T* const values, size_t const count) { unary<CosOperation<T>>(values, count); }
+
+        static void tg(T* const values, size_t const count) { unary<TgOperation<T>>(values, count); }
+
+        static void ctg(T* const values, size_t const count) { unary<CtgOperation<T>>(values, count); }
+
+        static void plus(T* const left, T const* const right, size_t const count) {
+            binary<PlusOperation<T>>(left, right, count);
+        }
+
+        static void minus(T* const left, T const* const right, size_t const count) {
+            binary<MinusOperation<T>>(left, right, count);
+        }
+
+        static void multiply(T* const left, T const* const right, size_t const count) {
+            binary<MultiplyOperation<T>>(left, right, count);
+        }
+
+        static void pow(T* const left, T const* const right, size_t const count) {
+            binary<PowOperation<T>>(left, right, count);
+        }
+    };
+
+    /**
+     * @brief Kernels applying an operation to whole blocks of values in place.
+     *
+     * @tparam T type of the values
+     */
+    template<typename T>
+    struct BatchKernels : ScalarBatchKernels<T> {};
+
+    template<>
+    struct BatchKernels<double> : ScalarBatchKernels<double> {
+        static void divide(double* const left, double const* const right, size_t const count) {
+            if (std::find(right, right + count, 0.) != right + count) throw OperationError("Division by zero");
+            SimdDoubleKernels::divide(left, right, count);
+        }
+
+        static void sqrt(double* const values, size_t const count) { SimdDoubleKernels::sqrt(values, count); }
+
+        static void sin(double* const values, size_t const count) { SimdDoubleKernels::sin(values, count); }
+
+        static void cos(double* const values, size_t const count) { SimdDoubleKernels::cos(values, count); }
+
+        static void tg(double* const values, size_t const count) { SimdDoubleKernels::tg(values, count); }
+
+        static void ctg(double* const values, size_t const count) { SimdDoubleKernels::ctg(values, count); }
+
+        static void pow(double* const left, double const* const right, size_t const count) {
+            SimdDoubleKernels::pow(left, right, count);
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_BATCH_KERNELS_H_
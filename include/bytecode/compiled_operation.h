@@ -0,0 +1,38 @@
+#ifndef INCLUDE_COMPILED_OPERATION_H_
+#define INCLUDE_COMPILED_OPERATION_H_
+
+#include <bytecode/program_compiler.h>
+#include <memory>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Operation evaluated by its compiled program.
+     *
+     * As the program computes every shared node of a DAG only once this is the way
+     * to evaluate DAGs whose operations have common sub-expressions.
+     * Visitors are passed to the source operation so this one is transparent for them.
+     *
+     * @tparam T result of the operation
+     */
+    template<typename T>
+    class CompiledOperation final : public Operation<T> {
+        std::shared_ptr<Operation<T>> const source_;
+        Program<T> const program_;
+
+    public:
+        explicit CompiledOperation(std::shared_ptr<Operation<T>> source)
+            : source_(std::move(source)), program_(compile(*source_)) {}
+
+        std::shared_ptr<Operation<T>> const& source() const noexcept { return source_; }
+
+        Program<T> const& program() const noexcept { return program_; }
+
+        T result(Variables<T> const& variables) const override { return program_.result(variables); }
+
+        void accept(OperationVisitor<T>& visitor) const override { source_->accept(visitor); }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_COMPILED_OPERATION_H_
@@ -0,0 +1,233 @@
+#ifndef INCLUDE_GRADIENT_EVALUATOR_H_
+#define INCLUDE_GRADIENT_EVALUATOR_H_
+
+#include <algorithm>
+#include <bit>
+#include <bytecode/program_compiler.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Value of an operation together with its partial derivatives by the variables on which it depends.
+     */
+    template<typename T>
+    struct Gradient {
+        T value;
+        uint64_t variables;         // mask of the slots of the variables of the derivatives
+        std::vector<T> derivatives; // ordered by the slots of the variables
+
+        /**
+         * @brief Gets the partial derivative by the variable with the given name, zero if there is no such variable.
+         *
+         * @throws std::invalid_argument if the name is not a latin letter
+         */
+        T derivative(char const name) const {
+            if (!Variables<T>::isName(name))
+                throw std::invalid_argument("Invalid variable name: " + std::string(1, name));
+
+            auto const slot = Variables<T>::slotOf(name);
+            if ((variables >> slot & 1) == 0) return T{};
+
+            return derivatives[size_t(std::popcount(variables & ((uint64_t(1) << slot) - 1)))];
+        }
+    };
+
+    /**
+     * @brief Evaluator of an operation computing its value and all its partial derivatives in a single pass.
+     *
+     * The compiled program of the operation is run on dual numbers: each value of the stack is accompanied
+     * by the row of its derivatives by the variables of the operation, which are propagated by the chain rule.
+     * The cost of an evaluation is thus about that of `N + 1` evaluations for `N` variables
+     * rather than of `2N + 1` ones of central finite differences. The derivatives are exact for exact types
+     * except for those involving transcendental functions and logarithms (of bases of powers to variable exponents)
+     * which are computed to `Precision::digits()` digits as the functions themselves are.
+     * Derivatives are only computed for the rows which are not zero, so constant subtrees cost as usual.
+     *
+     * @tparam T result of the evaluated operation
+     */
+    template<typename T>
+    class GradientEvaluator final {
+        Program<T> program_;
+        uint64_t variables_ = 0;
+        size_t count_;
+
+        static bool isZero(T const* const row, size_t const count) {
+            return std::all_of(row, row + count, [](T const& derivative) { return derivative == T{}; });
+        }
+
+        // multiplies the row by the factor which is only computed if the row is not zero
+        template<typename F>
+        void scale(T* const row, F&& factor) const {
+            if (isZero(row, count_)) return;
+
+            auto const value = factor();
+            for (auto derivative = row; derivative != row + count_; ++derivative) *derivative *= value;
+        }
+
+        static T logarithm(T const& value) {
+            if constexpr (std::is_floating_point_v<T>) return std::log(value);
+            else {
+                if (value <= T{}) throw OperationError("Power of a non-positive number to a variable exponent");
+                return Transcendental<T>::ln(value);
+            }
+        }
+
+    public:
+        explicit GradientEvaluator(Operation<T> const& operation) : program_(compile(operation)) {
+            for (auto const& instruction : program_.instructions())
+                if (instruction.code == OpCode::VARIABLE) variables_ |= uint64_t(1) << instruction.argument;
+            count_ = size_t(std::popcount(variables_));
+        }
+
+        Program<T> const& program() const noexcept { return program_; }
+
+        /**
+         * @brief Gets the mask of the slots of the variables on which the operation depends.
+         */
+        uint64_t variables() const noexcept { return variables_; }
+
+        /**
+         * @brief Gets the value of the operation and its partial derivatives.
+         *
+         * @throws OperationError if the value can't be computed or a derivative requires a division by zero
+         */
+        Gradient<T> gradient(Variables<T> const& variables) const {
+            auto const& constants = program_.constants();
+            std::vector<T> values(program_.stackSize()), derivatives(program_.stackSize() * count_);
+            auto const row = [&](size_t const index) { return derivatives.data() + index * count_; };
+            auto top = program_.temporaries(); // index right after the topmost value
+
+            for (auto const& instruction : program_.instructions()) {
+                auto const argument = size_t(instruction.argument);
+                switch (instruction.code) {
+                    case OpCode::CONSTANT: {
+                        values[top] = constants[argument];
+                        std::fill_n(row(top++), count_, T{});
+                        break;
+                    }
+                    case OpCode::VARIABLE: {
+                        values[top] = VariableOperation<T>::compute(variables, argument);
+                        std::fill_n(row(top), count_, T{});
+                        row(top++)[std::popcount(variables_ & ((uint64_t(1) << argument) - 1))] = T(1);
+                        break;
+                    }
+                    case OpCode::LOAD: {
+                        values[top] = values[argument];
+                        std::copy_n(row(argument), count_, row(top++));
+                        break;
+                    }
+                    case OpCode::STORE: {
+                        values[argument] = values[top - 1];
+                        std::copy_n(row(top - 1), count_, row(argument));
+                        break;
+                    }
+                    case OpCode::PLUS:
+                    case OpCode::MINUS: {
+                        auto const right = --top, left = top - 1;
+                        auto const plus = instruction.code == OpCode::PLUS;
+                        values[left] = plus ? PlusOperation<T>::compute(values[left], values[right])
+                                            : MinusOperation<T>::compute(values[left], values[right]);
+                        for (size_t i = 0; i < count_; ++i) {
+                            if (plus) row(left)[i] += row(right)[i];
+                            else row(left)[i] -= row(right)[i];
+                        }
+                        break;
+                    }
+                    case OpCode::NEGATIVE:
+                    case OpCode::INVERT: {
+                        values[top - 1] = NegativeOperation<T>::compute(values[top - 1]);
+                        for (size_t i = 0; i < count_; ++i) row(top - 1)[i] = -row(top - 1)[i];
+                        break;
+                    }
+                    case OpCode::MULTIPLY: {
+                        auto const right = --top, left = top - 1;
+                        for (size_t i = 0; i < count_; ++i)
+                            row(left)[i] = row(left)[i] * values[right] + values[left] * row(right)[i];
+                        values[left] = MultiplyOperation<T>::compute(values[left], values[right]);
+                        break;
+                    }
+                    case OpCode::DIVIDE: {
+                        auto const right = --top, left = top - 1;
+                        values[left] = DivideOperation<T>::compute(values[left], values[right]);
+                        for (size_t i = 0; i < count_; ++i)
+                            row(left)[i] = (row(left)[i] - values[left] * row(right)[i]) / values[right];
+                        break;
+                    }
+                    case OpCode::POW: {
+                        // (a^b)' = b a^(b-1) a' + a^b ln(a) b'
+                        auto const right = --top, left = top - 1;
+                        auto const& base = values[left];
+                        auto const& exponent = values[right];
+                        auto const value = PowOperation<T>::compute(base, exponent);
+                        scale(row(left), [&] { return exponent * PowOperation<T>::compute(base, exponent - T(1)); });
+                        scale(row(right), [&] { return value * logarithm(base); });
+                        for (size_t i = 0; i < count_; ++i) row(left)[i] += row(right)[i];
+                        values[left] = value;
+                        break;
+                    }
+                    case OpCode::SQRT: {
+                        values[top - 1] = PrimitiveSqrtOperation<T>::compute(values[top - 1]);
+                        scale(row(top - 1), [&] { return DivideOperation<T>::compute(T(1), T(2) * values[top - 1]); });
+                        break;
+                    }
+                    case OpCode::SUM: {
+                        auto const first = top - argument;
+                        for (size_t i = 0; i < count_; ++i) {
+                            typename SumAccumulator<T>::type sum{};
+                            for (auto operand = first; operand != top; ++operand) sum += row(operand)[i];
+                            row(first)[i] = SumAccumulator<T>::value(std::move(sum));
+                        }
+                        values[first] = VectorSumOperation<T>::compute(values.data() + first, argument);
+                        top = first + 1;
+                        break;
+                    }
+                    case OpCode::SIN: {
+                        scale(row(top - 1), [&] { return CosOperation<T>::compute(values[top - 1]); });
+                        values[top - 1] = SinOperation<T>::compute(values[top - 1]);
+                        break;
+                    }
+                    case OpCode::COS: {
+                        scale(row(top - 1), [&] { return -SinOperation<T>::compute(values[top - 1]); });
+                        values[top - 1] = CosOperation<T>::compute(values[top - 1]);
+                        break;
+                    }
+                    case OpCode::TG:
+                    case OpCode::CTG: {
+                        // tg' = 1 + tg^2 and ctg' = -(1 + ctg^2)
+                        auto const tangent = instruction.code == OpCode::TG;
+                        values[top - 1] = tangent ? TgOperation<T>::compute(values[top - 1])
+                                                  : CtgOperation<T>::compute(values[top - 1]);
+                        scale(row(top - 1), [&] {
+                            auto const square = T(1) + values[top - 1] * values[top - 1];
+                            return tangent ? square : -square;
+                        });
+                        break;
+                    }
+                }
+            }
+
+            auto const result = program_.temporaries();
+            auto const first = std::make_move_iterator(row(result));
+            return {std::move(values[result]), variables_, std::vector<T>(first, first + ptrdiff_t(count_))};
+        }
+    };
+
+    /**
+     * @brief Gets the value of the operation and its partial derivatives by all the variables it depends on.
+     */
+    template<typename T>
+    Gradient<T> gradient(Operation<T> const& operation, Variables<T> const& variables) {
+        return GradientEvaluator<T>(operation).gradient(variables);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_GRADIENT_EVALUATOR_H_
@@ -0,0 +1,148 @@
+#ifndef INCLUDE_INCREMENTAL_EVALUATOR_H_
+#define INCLUDE_INCREMENTAL_EVALUATOR_H_
+
+#include <algorithm>
+#include <array>
+#include <bytecode/program_graph.h>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Evaluator keeping the value of every node of an operation so that a change of a variable
+     * only recomputes the nodes depending on it.
+     *
+     * The nodes are those of the graph of the compiled operation so operations shared in a DAG are single nodes.
+     * The cost of an update is proportional to the number of the nodes on the paths from the leaves
+     * of the changed variable to the root rather than to the size of the whole operation.
+     * Sums of exact types are updated by the differences of their changed operands so wide ones are cheap too.
+     *
+     * @tparam T result of the evaluated operation
+     */
+    template<typename T>
+    class IncrementalEvaluator final {
+        ProgramGraph<T> graph_;
+        Variables<T> variables_;
+        std::vector<T> values_;
+        std::vector<std::exception_ptr> errors_; // errors of the nodes which can't be evaluated
+        std::array<std::vector<uint32_t>, Variables<T>::SLOTS> leaves_;
+        std::vector<bool> dirty_;
+        std::vector<uint32_t> pending_;
+        std::vector<bool> summed_;                     // whether a node is an operand of a sum
+        std::vector<std::pair<uint32_t, T>> previous_; // values of the updated operands of sums before the update
+
+        void recompute(size_t const index) {
+            errors_[index] = nullptr;
+            for (auto const operand : graph_.nodes()[index].operands)
+                if (errors_[operand]) {
+                    errors_[index] = errors_[operand];
+                    return;
+                }
+
+            try {
+                values_[index] = graph_.compute(index, variables_, values_);
+            } catch (...) { errors_[index] = std::current_exception(); }
+        }
+
+        // exact sums are updated by the differences of their changed operands rather than added up again
+        bool updateSum(uint32_t const index) {
+            if constexpr (std::is_floating_point_v<T>) return false;
+            else {
+                if (errors_[index]) return false;
+
+                T difference{};
+                for (auto const operand : graph_.nodes()[index].operands) {
+                    if (!dirty_[operand]) continue;
+
+                    // the previous values are ordered by the nodes as the nodes are updated in this order
+                    auto const byNode = [](std::pair<uint32_t, T> const& value, uint32_t const node) {
+                        return value.first < node;
+                    };
+                    auto const previous = std::lower_bound(previous_.begin(), previous_.end(), operand, byNode);
+                    if (previous == previous_.end() || previous->first != operand || errors_[operand]) return false;
+                    difference += values_[operand] - previous->second;
+                }
+                values_[index] += difference;
+
+                return true;
+            }
+        }
+
+        void update(uint32_t const index) {
+            if (graph_.nodes()[index].code == OpCode::SUM && updateSum(index)) return;
+
+            if (summed_[index] && !errors_[index]) previous_.emplace_back(index, values_[index]);
+            recompute(index);
+        }
+
+        void markDirty(uint32_t const index) {
+            if (dirty_[index]) return;
+
+            dirty_[index] = true;
+            pending_.push_back(index);
+            for (auto const parent : graph_.nodes()[index].parents) markDirty(parent);
+        }
+
+    public:
+        /**
+         * @param operation evaluated operation
+         * @param variables initial values of the variables
+         */
+        explicit IncrementalEvaluator(Operation<T> const& operation, Variables<T> variables = {})
+            : graph_(compile(operation)), variables_(std::move(variables)) {
+            auto const& nodes = graph_.nodes();
+            values_.resize(nodes.size());
+            errors_.resize(nodes.size());
+            dirty_.resize(nodes.size());
+            summed_.resize(nodes.size());
+            for (size_t index = 0; index < nodes.size(); ++index) {
+                auto const& node = nodes[index];
+                if (node.code == OpCode::VARIABLE) leaves_[node.argument].push_back(static_cast<uint32_t>(index));
+                if (node.code == OpCode::SUM)
+                    for (auto const operand : node.operands) summed_[operand] = true;
+                recompute(index);
+            }
+        }
+
+        Variables<T> const& variables() const noexcept { return variables_; }
+
+        /**
+         * @brief Gets the number of the nodes recomputed by the last change of a variable.
+         */
+        size_t recomputed() const noexcept { return pending_.size(); }
+
+        /**
+         * @brief Changes the value of a variable recomputing the nodes which depend on it.
+         *
+         * @throws std::invalid_argument if the name is not a variable name
+         */
+        void setVariable(char const name, T value) {
+            variables_.set(name, std::move(value));
+
+            pending_.clear();
+            previous_.clear();
+            for (auto const leaf : leaves_[Variables<T>::slotOf(name)]) markDirty(leaf);
+            std::sort(pending_.begin(), pending_.end()); // operands first
+            for (auto const index : pending_) update(index);
+            for (auto const index : pending_) dirty_[index] = false;
+        }
+
+        /**
+         * @brief Gets the result for the current values of the variables.
+         *
+         * @throws the error of the evaluation, e.g. OperationError if some variable has no value
+         */
+        T const& result() const {
+            auto const root = graph_.root();
+            if (errors_[root]) std::rethrow_exception(errors_[root]);
+
+            return values_[root];
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_INCREMENTAL_EVALUATOR_H_
@@ -0,0 +1,65 @@
+#ifndef INCLUDE_PARALLEL_EVALUATOR_H_
+#define INCLUDE_PARALLEL_EVALUATOR_H_
+
+#include <bytecode/program_compiler.h>
+#include <concurrent/thread_pool.h>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Evaluates the program for each row of variables splitting the rows between the threads of the pool.
+     *
+     * Each result is written at the index of its row so the results don't depend on the number of threads.
+     *
+     * @param rows values of the variables, one binding per row
+     * @param results values to which the results are written, should have at least `rows.size()` elements
+     * @param grain minimal number of rows evaluated by a single task
+     * @throws the exception of the first row whose evaluation has failed
+     */
+    template<typename T>
+    void evaluateParallel(Program<T> const& program, std::span<Variables<T> const> const rows,
+                          std::span<T> const results, ThreadPool& pool = ThreadPool::shared(),
+                          size_t const grain = 256) {
+        if (results.size() < rows.size()) throw OperationError("Not enough space for the results");
+
+        size_t failedRow = SIZE_MAX;
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        pool.parallelFor(rows.size(), grain, [&](size_t const begin, size_t const end) {
+            std::vector<T> stack(program.stackSize()); // reused by all the rows of the range
+            for (auto row = begin; row < end; ++row) {
+                try {
+                    results[row] = program.result(rows[row], stack.data());
+                } catch (...) {
+                    std::lock_guard lock(errorMutex);
+                    if (row < failedRow) {
+                        failedRow = row;
+                        error = std::current_exception();
+                    }
+                    return; // the rows after this one can't fail first
+                }
+            }
+        });
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Evaluates the operation for each row of variables splitting the rows between the threads of the pool.
+     *
+     * @see evaluateParallel(Program<T> const&, std::span<Variables<T> const>, std::span<T>, ThreadPool&, size_t)
+     */
+    template<typename T>
+    void evaluateParallel(Operation<T> const& operation, std::span<Variables<T> const> const rows,
+                          std::span<T> const results, ThreadPool& pool = ThreadPool::shared(),
+                          size_t const grain = 256) {
+        evaluateParallel(compile(operation), rows, results, pool, grain);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_PARALLEL_EVALUATOR_H_
@@ -0,0 +1,180 @@
+#ifndef INCLUDE_PROGRAM_H_
+#define INCLUDE_PROGRAM_H_
+
+#include <cstdint>
+#include <operation/algebraic_operations.h>
+#include <operation/const_operation.h>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    enum class OpCode : uint8_t {
+        CONSTANT, // pushes the constant with index `argument`
+        VARIABLE, // pushes the variable with slot `argument`
+        LOAD,     // pushes the temporary with index `argument`
+        STORE,    // copies the topmost value to the temporary with index `argument`
+        PLUS,
+        NEGATIVE,
+        MINUS,
+        MULTIPLY,
+        DIVIDE,
+        INVERT,
+        POW,
+        SQRT,
+        SUM, // pops `argument` values and pushes their sum
+        SIN,
+        COS,
+        TG,
+        CTG
+    };
+
+    struct Instruction {
+        OpCode code;
+        uint32_t argument;
+    };
+
+    /**
+     * @brief An operation lowered into a flat post-order sequence of instructions of a stack machine.
+     *
+     * Values of shared operations are kept in temporaries which precede the value stack
+     * so that the whole memory required by the program is a single array of `stackSize()` values.
+     *
+     * @tparam T result of the program
+     */
+    template<typename T>
+    class Program final {
+        std::vector<Instruction> instructions_;
+        std::vector<T> constants_;
+        size_t temporaries_, stackSize_;
+
+    public:
+        Program(std::vector<Instruction> instructions, std::vector<T> constants, size_t const temporaries,
+                size_t const depth) noexcept
+            : instructions_(std::move(instructions)), constants_(std::move(constants)), temporaries_(temporaries),
+              stackSize_(temporaries + depth) {}
+
+        std::vector<Instruction> const& instructions() const noexcept { return instructions_; }
+
+        std::vector<T> const& constants() const noexcept { return constants_; }
+
+        size_t temporaries() const noexcept { return temporaries_; }
+
+        size_t stackSize() const noexcept { return stackSize_; }
+
+        /**
+         * @brief Gets the result of this program allocating a temporary stack for it.
+         *
+         * @return result of this program
+         */
+        T result(Variables<T> const& variables) const {
+            std::vector<T> stack(stackSize_);
+            return result(variables, stack.data());
+        }
+
+        /**
+         * @brief Gets the result of this program reusing the given stack.
+         *
+         * @param stack stack which will be grown to the required size if it is smaller
+         * @return result of this program
+         */
+        T result(Variables<T> const& variables, std::vector<T>& stack) const {
+            if (stack.size() < stackSize_) stack.resize(stackSize_);
+            return result(variables, stack.data());
+        }
+
+        /**
+         * @brief Gets the result of this program using the given stack.
+         *
+         * @param stack pointer to at least `stackSize()` values
+         * @return result of this program
+         */
+        T result(Variables<T> const& variables, T* const stack) const {
+            auto top = stack + temporaries_; // points right after the topmost value
+            for (auto const& instruction : instructions_) {
+                switch (instruction.code) {
+                    case OpCode::CONSTANT: {
+                        *top++ = constants_[instruction.argument];
+                        break;
+                    }
+                    case OpCode::VARIABLE: {
+                        *top++ = VariableOperation<T>::compute(variables, instruction.argument);
+                        break;
+                    }
+                    case OpCode::LOAD: {
+                        *top++ = stack[instruction.argument];
+                        break;
+                    }
+                    case OpCode::STORE: {
+                        stack[instruction.argument] = top[-1];
+                        break;
+                    }
+                    case OpCode::PLUS: {
+                        --top;
+                        top[-1] = PlusOperation<T>::compute(top[-1], *top);
+                        break;
+                    }
+                    case OpCode::NEGATIVE: {
+                        top[-1] = NegativeOperation<T>::compute(top[-1]);
+                        break;
+                    }
+                    case OpCode::MINUS: {
+                        --top;
+                        top[-1] = MinusOperation<T>::compute(top[-1], *top);
+                        break;
+                    }
+                    case OpCode::MULTIPLY: {
+                        --top;
+                        top[-1] = MultiplyOperation<T>::compute(top[-1], *top);
+                        break;
+                    }
+                    case OpCode::DIVIDE: {
+                        --top;
+                        top[-1] = DivideOperation<T>::compute(top[-1], *top);
+                        break;
+                    }
+                    case OpCode::INVERT: {
+                        top[-1] = InvertOperation<T>::compute(top[-1]);
+                        break;
+                    }
+                    case OpCode::POW: {
+                        --top;
+                        top[-1] = PowOperation<T>::compute(top[-1], *top);
+                        break;
+                    }
+                    case OpCode::SQRT: {
+                        top[-1] = PrimitiveSqrtOperation<T>::compute(top[-1]);
+                        break;
+                    }
+                    case OpCode::SUM: {
+                        auto const first = top - instruction.argument;
+                        auto sum = VectorSumOperation<T>::compute(first, instruction.argument);
+                        top = first;
+                        *top++ = std::move(sum);
+                        break;
+                    }
+                    case OpCode::SIN: {
+                        top[-1] = SinOperation<T>::compute(top[-1]);
+                        break;
+                    }
+                    case OpCode::COS: {
+                        top[-1] = CosOperation<T>::compute(top[-1]);
+                        break;
+                    }
+                    case OpCode::TG: {
+                        top[-1] = TgOperation<T>::compute(top[-1]);
+                        break;
+                    }
+                    case OpCode::CTG: {
+                        top[-1] = CtgOperation<T>::compute(top[-1]);
+                        break;
+                    }
+                }
+            }
+
+            return std::move(stack[temporaries_]);
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_PROGRAM_H_
@@ -0,0 +1,134 @@
+#ifndef INCLUDE_PROGRAM_COMPILER_H_
+#define INCLUDE_PROGRAM_COMPILER_H_
+
+#include <algorithm>
+#include <bytecode/program.h>
+#include <memory>
+#include <operation/operation_operands.h>
+#include <unordered_map>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Lowers an AST into a flat program by emitting its operations in post-order.
+     *
+     * Operations shared by several parents of a DAG are emitted only once,
+     * their value is stored to a temporary and loaded from it by the other parents.
+     *
+     * @tparam T result of the compiled operations
+     */
+    template<typename T>
+    class ProgramCompiler final : public OperationVisitor<T> {
+        std::vector<Instruction> instructions_;
+        std::vector<T> constants_;
+        size_t depth_ = 0, maxDepth_ = 0;
+        std::unordered_map<Operation<T> const*, size_t> references_;   // numbers of parents of shared operations
+        std::unordered_map<Operation<T> const*, uint32_t> temporaries_; // temporaries of already emitted ones
+
+        // leaves are not counted as loading them is as cheap as recomputing
+        void countReferences(std::vector<std::shared_ptr<Operation<T>>> const& operands) {
+            for (auto const& operand : operands) {
+                auto const operandOperands = operandsOf(*operand);
+                if (!operandOperands.empty() && ++references_[operand.get()] == 1) countReferences(operandOperands);
+            }
+        }
+
+        void emitOperand(std::shared_ptr<Operation<T>> const& operand) {
+            auto const references = references_.find(operand.get());
+            if (references == references_.end() || references->second == 1) return operand->accept(*this);
+
+            auto const [temporary, inserted] =
+                    temporaries_.try_emplace(operand.get(), static_cast<uint32_t>(temporaries_.size()));
+            if (!inserted) return emit(OpCode::LOAD, temporary->second, 0, 1);
+
+            operand->accept(*this);
+            emit(OpCode::STORE, temporary->second, 0, 0);
+        }
+
+        void emit(OpCode const code, uint32_t const argument, size_t const popped, size_t const pushed) {
+            instructions_.push_back({code, argument});
+            depth_ = depth_ - popped + pushed;
+            maxDepth_ = std::max(maxDepth_, depth_);
+        }
+
+        void emitConstant(T&& value) {
+            emit(OpCode::CONSTANT, static_cast<uint32_t>(constants_.size()), 0, 1);
+            constants_.push_back(std::move(value));
+        }
+
+        void emitUnary(OpCode const code, UnaryOperation<T> const& operation) {
+            emitOperand(operation.operand());
+            emit(code, 0, 1, 1);
+        }
+
+        void emitBinary(OpCode const code, BinaryOperation<T> const& operation) {
+            emitOperand(operation.leftOperand());
+            emitOperand(operation.rightOperand());
+            emit(code, 0, 2, 1);
+        }
+
+    public:
+        /**
+         * @brief Compiles the given operation into a program.
+         *
+         * @param operation root of the compiled AST
+         * @return program having the same result as the operation
+         */
+        static Program<T> compile(Operation<T> const& operation) {
+            ProgramCompiler compiler;
+            compiler.countReferences(operandsOf(operation));
+            operation.accept(compiler);
+
+            return Program<T>(std::move(compiler.instructions_), std::move(compiler.constants_),
+                              compiler.temporaries_.size(), compiler.maxDepth_);
+        }
+
+        void visit(ConstOperation<T> const& operation) override { emitConstant(T(operation.value())); }
+
+        void visit(ConstEOperation<T> const& operation) override { emitConstant(ConstEOperation<T>::compute()); }
+
+        void visit(ConstPiOperation<T> const& operation) override { emitConstant(ConstPiOperation<T>::compute()); }
+
+        void visit(VariableOperation<T> const& operation) override {
+            emit(OpCode::VARIABLE, static_cast<uint32_t>(operation.slot()), 0, 1);
+        }
+
+        void visit(PlusOperation<T> const& operation) override { emitBinary(OpCode::PLUS, operation); }
+
+        void visit(NegativeOperation<T> const& operation) override { emitUnary(OpCode::NEGATIVE, operation); }
+
+        void visit(MinusOperation<T> const& operation) override { emitBinary(OpCode::MINUS, operation); }
+
+        void visit(MultiplyOperation<T> const& operation) override { emitBinary(OpCode::MULTIPLY, operation); }
+
+        void visit(DivideOperation<T> const& operation) override { emitBinary(OpCode::DIVIDE, operation); }
+
+        void visit(InvertOperation<T> const& operation) override { emitUnary(OpCode::INVERT, operation); }
+
+        void visit(PowOperation<T> const& operation) override { emitBinary(OpCode::POW, operation); }
+
+        void visit(PrimitiveSqrtOperation<T> const& operation) override { emitUnary(OpCode::SQRT, operation); }
+
+        void visit(VectorSumOperation<T> const& operation) override {
+            auto const& operands = operation.operands();
+            for (auto const& operand : operands) emitOperand(operand);
+            emit(OpCode::SUM, static_cast<uint32_t>(operands.size()), operands.size(), 1);
+        }
+
+        void visit(SinOperation<T> const& operation) override { emitUnary(OpCode::SIN, operation); }
+
+        void visit(CosOperation<T> const& operation) override { emitUnary(OpCode::COS, operation); }
+
+        void visit(TgOperation<T> const& operation) override { emitUnary(OpCode::TG, operation); }
+
+        void visit(CtgOperation<T> const& operation) override { emitUnary(OpCode::CTG, operation); }
+    };
+
+    template<typename T>
+    Program<T> compile(Operation<T> const& operation) {
+        return ProgramCompiler<T>::compile(operation);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_PROGRAM_COMPILER_H_
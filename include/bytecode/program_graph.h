@@ -0,0 +1,108 @@
+#ifndef INCLUDE_PROGRAM_GRAPH_H_
+#define INCLUDE_PROGRAM_GRAPH_H_
+
+#include <bytecode/program_compiler.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    struct ProgramNode {
+        OpCode code;
+        uint32_t argument;
+        std::vector<uint32_t> operands, parents;
+    };
+
+    /**
+     * @brief Graph of the values computed by a program, one node per value computing instruction.
+     *
+     * Loads and stores of temporaries become shared operands so the graph is the DAG of the compiled operation.
+     * The nodes are in post-order so operands always precede their parents and the root is the last node.
+     *
+     * @tparam T result of the program
+     */
+    template<typename T>
+    class ProgramGraph final {
+        Program<T> const program_;
+        std::vector<ProgramNode> nodes_;
+        std::vector<T> sumOperands_;
+
+        static size_t operandsOf(Instruction const& instruction) noexcept {
+            switch (instruction.code) {
+                case OpCode::CONSTANT:
+                case OpCode::VARIABLE: return 0;
+                case OpCode::PLUS:
+                case OpCode::MINUS:
+                case OpCode::MULTIPLY:
+                case OpCode::DIVIDE:
+                case OpCode::POW: return 2;
+                case OpCode::SUM: return instruction.argument;
+                default: return 1;
+            }
+        }
+
+    public:
+        explicit ProgramGraph(Program<T> program) : program_(std::move(program)) {
+            std::vector<uint32_t> stack, temporaries(program_.temporaries());
+            for (auto const& instruction : program_.instructions()) {
+                if (instruction.code == OpCode::LOAD) {
+                    stack.push_back(temporaries[instruction.argument]);
+                    continue;
+                }
+                if (instruction.code == OpCode::STORE) {
+                    temporaries[instruction.argument] = stack.back();
+                    continue;
+                }
+
+                auto const index = static_cast<uint32_t>(nodes_.size());
+                auto const operands = operandsOf(instruction);
+                ProgramNode node{instruction.code, instruction.argument, {stack.end() - operands, stack.end()}, {}};
+                stack.resize(stack.size() - operands);
+                for (auto const operand : node.operands) nodes_[operand].parents.push_back(index);
+                nodes_.push_back(std::move(node));
+                stack.push_back(index);
+            }
+        }
+
+        Program<T> const& program() const noexcept { return program_; }
+
+        std::vector<ProgramNode> const& nodes() const noexcept { return nodes_; }
+
+        size_t root() const noexcept { return nodes_.size() - 1; }
+
+        /**
+         * @brief Computes the value of a node from the values of its operands.
+         *
+         * @param values values of the nodes, only those of the operands are read
+         */
+        T compute(size_t const index, Variables<T> const& variables, std::vector<T> const& values) {
+            auto const& node = nodes_[index];
+            auto const operand = [&](size_t const i) -> T const& { return values[node.operands[i]]; };
+            switch (node.code) {
+                case OpCode::CONSTANT: return program_.constants()[node.argument];
+                case OpCode::VARIABLE: return VariableOperation<T>::compute(variables, node.argument);
+                case OpCode::PLUS: return PlusOperation<T>::compute(operand(0), operand(1));
+                case OpCode::NEGATIVE: return NegativeOperation<T>::compute(operand(0));
+                case OpCode::MINUS: return MinusOperation<T>::compute(operand(0), operand(1));
+                case OpCode::MULTIPLY: return MultiplyOperation<T>::compute(operand(0), operand(1));
+                case OpCode::DIVIDE: return DivideOperation<T>::compute(operand(0), operand(1));
+                case OpCode::INVERT: return InvertOperation<T>::compute(operand(0));
+                case OpCode::POW: return PowOperation<T>::compute(operand(0), operand(1));
+                case OpCode::SQRT: return PrimitiveSqrtOperation<T>::compute(operand(0));
+                case OpCode::SUM: {
+                    sumOperands_.clear();
+                    for (auto const operandIndex : node.operands) sumOperands_.push_back(values[operandIndex]);
+                    return VectorSumOperation<T>::compute(sumOperands_.data(), sumOperands_.size());
+                }
+                case OpCode::SIN: return SinOperation<T>::compute(operand(0));
+                case OpCode::COS: return CosOperation<T>::compute(operand(0));
+                case OpCode::TG: return TgOperation<T>::compute(operand(0));
+                case OpCode::CTG: return CtgOperation<T>::compute(operand(0));
+                default: throw OperationError("Unexpected instruction in a program graph");
+            }
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_PROGRAM_GRAPH_H_
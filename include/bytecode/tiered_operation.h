@@ -0,0 +1,53 @@
+#ifndef INCLUDE_TIERED_OPERATION_H_
+#define INCLUDE_TIERED_OPERATION_H_
+
+#include <bytecode/tiered_program.h>
+#include <concurrent/parallel_sum_operation.h>
+#include <memory>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Operation evaluated by its tiered program which is compiled once with the operation.
+     *
+     * If the operation has wide sums worth the threads (see `parallelize`) its exact tier evaluates the tree
+     * with these sums made parallel rather than the program.
+     * Visitors are passed to the source operation so this one is transparent for them.
+     *
+     * @tparam T result of the operation
+     */
+    template<typename T>
+    class TieredOperation final : public Operation<T> {
+        std::shared_ptr<Operation<T>> const source_;
+        TieredProgram<T> const program_;
+        std::shared_ptr<Operation<T>> parallel_; // the source with parallel sums if it has any
+
+    public:
+        explicit TieredOperation(std::shared_ptr<Operation<T>> source)
+            : source_(std::move(source)), program_(compileTiered(*source_)) {
+            OperationParallelizer<T> parallelizer;
+            auto parallel = parallelizer.transform(source_);
+            if (parallelizer.parallelized() != 0) parallel_ = std::move(parallel);
+        }
+
+        std::shared_ptr<Operation<T>> const& source() const noexcept { return source_; }
+
+        TieredProgram<T> const& program() const noexcept { return program_; }
+
+        /**
+         * @brief Gets the result of this operation together with the tier which has computed it.
+         */
+        TieredResult<T> tieredResult(Variables<T> const& variables) const {
+            if (auto const integer = program_.integerResult(variables)) return {T(*integer), Tier::INTEGER};
+
+            return {parallel_ ? parallel_->result(variables) : program_.program().result(variables), Tier::EXACT};
+        }
+
+        T result(Variables<T> const& variables) const override { return tieredResult(variables).value; }
+
+        void accept(OperationVisitor<T>& visitor) const override { source_->accept(visitor); }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_TIERED_OPERATION_H_
@@ -0,0 +1,189 @@
+#ifndef INCLUDE_TIERED_PROGRAM_H_
+#define INCLUDE_TIERED_PROGRAM_H_
+
+#include <algorithm>
+#include <bytecode/program_compiler.h>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Arithmetic which has produced a result of a tiered program.
+     */
+    enum class Tier : uint8_t {
+        INTEGER, // checked 64-bit integers
+        EXACT    // the type of the program itself
+    };
+
+    inline char const* tierName(Tier const tier) noexcept { return tier == Tier::INTEGER ? "int64" : "exact"; }
+
+    template<typename T>
+    struct TieredResult {
+        T value;
+        Tier tier;
+    };
+
+    /**
+     * @brief Program evaluated with checked 64-bit integers first and with its own type only if that fails.
+     *
+     * The integer evaluation fails on overflows, divisions with remainders, non-integer values
+     * and functions which are not exact. Its results equal those of the program itself
+     * so for the usual small integer expressions none of the costly arithmetic of `T` happens.
+     *
+     * @tparam T result of the program
+     */
+    template<typename T>
+    class TieredProgram final {
+        Program<T> program_;
+        std::vector<int64_t> integerConstants_;
+        bool integral_; // whether all the constants are integers and all the instructions are exact for them
+
+        static constexpr size_t STACK_SIZE = 64;
+
+        static bool pow(int64_t base, int64_t exponent, int64_t& result) noexcept {
+            if (exponent < 0) return false;
+            result = 1;
+            while (exponent != 0) {
+                if ((exponent & 1) != 0 && __builtin_mul_overflow(result, base, &result)) return false;
+                exponent >>= 1;
+                if (exponent != 0 && __builtin_mul_overflow(base, base, &base)) return false;
+            }
+
+            return true;
+        }
+
+        bool integerResult(Variables<T> const& variables, int64_t* const stack, int64_t& result) const {
+            auto top = stack + program_.temporaries(); // points right after the topmost value
+            for (auto const& instruction : program_.instructions()) {
+                switch (instruction.code) {
+                    case OpCode::CONSTANT: {
+                        *top++ = integerConstants_[instruction.argument];
+                        break;
+                    }
+                    case OpCode::VARIABLE: {
+                        auto const value = variables.find(instruction.argument);
+                        if (!value) return false;
+                        auto const integer = toInteger(*value);
+                        if (!integer) return false;
+                        *top++ = *integer;
+                        break;
+                    }
+                    case OpCode::LOAD: {
+                        *top++ = stack[instruction.argument];
+                        break;
+                    }
+                    case OpCode::STORE: {
+                        stack[instruction.argument] = top[-1];
+                        break;
+                    }
+                    case OpCode::PLUS: {
+                        --top;
+                        if (__builtin_add_overflow(top[-1], *top, &top[-1])) return false;
+                        break;
+                    }
+                    case OpCode::NEGATIVE:
+                    case OpCode::INVERT: {
+                        if (__builtin_sub_overflow(int64_t(0), top[-1], &top[-1])) return false;
+                        break;
+                    }
+                    case OpCode::MINUS: {
+                        --top;
+                        if (__builtin_sub_overflow(top[-1], *top, &top[-1])) return false;
+                        break;
+                    }
+                    case OpCode::MULTIPLY: {
+                        --top;
+                        if (__builtin_mul_overflow(top[-1], *top, &top[-1])) return false;
+                        break;
+                    }
+                    case OpCode::DIVIDE: {
+                        --top;
+                        auto const divisor = *top;
+                        if (divisor == 0 || (divisor == -1 && top[-1] == std::numeric_limits<int64_t>::min())
+                            || top[-1] % divisor != 0)
+                            return false;
+                        top[-1] /= divisor;
+                        break;
+                    }
+                    case OpCode::POW: {
+                        --top;
+                        if (!pow(top[-1], *top, top[-1])) return false;
+                        break;
+                    }
+                    case OpCode::SUM: {
+                        int64_t sum = 0;
+                        auto const first = top - instruction.argument;
+                        for (auto element = first; element != top; ++element)
+                            if (__builtin_add_overflow(sum, *element, &sum)) return false;
+                        top = first;
+                        *top++ = sum;
+                        break;
+                    }
+                    default: return false; // functions are excluded by `integral_`
+                }
+            }
+
+            result = stack[program_.temporaries()];
+            return true;
+        }
+
+    public:
+        explicit TieredProgram(Program<T> program) : program_(std::move(program)), integral_(true) {
+            integerConstants_.reserve(program_.constants().size());
+            for (auto const& constant : program_.constants()) {
+                auto const integer = toInteger(constant);
+                integral_ = integral_ && integer;
+                integerConstants_.push_back(integer.value_or(0));
+            }
+
+            integral_ = integral_
+                        && std::none_of(program_.instructions().begin(), program_.instructions().end(),
+                                        [](Instruction const& instruction) {
+                                            auto const code = instruction.code;
+                                            return code == OpCode::SQRT || code == OpCode::SIN || code == OpCode::COS
+                                                   || code == OpCode::TG || code == OpCode::CTG;
+                                        });
+        }
+
+        Program<T> const& program() const noexcept { return program_; }
+
+        /**
+         * @brief Gets the result of this program computed by checked 64-bit integers if they compute it exactly.
+         */
+        std::optional<int64_t> integerResult(Variables<T> const& variables) const {
+            if (!integral_) return std::nullopt;
+
+            int64_t result;
+            auto const stackSize = program_.stackSize();
+            if (stackSize <= STACK_SIZE) {
+                int64_t stack[STACK_SIZE];
+                if (integerResult(variables, stack, result)) return result;
+            } else {
+                std::vector<int64_t> stack(stackSize);
+                if (integerResult(variables, stack.data(), result)) return result;
+            }
+
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Gets the result of this program using the cheapest tier which computes it exactly.
+         */
+        TieredResult<T> result(Variables<T> const& variables) const {
+            if (auto const integer = integerResult(variables)) return {T(*integer), Tier::INTEGER};
+
+            return {program_.result(variables), Tier::EXACT};
+        }
+    };
+
+    template<typename T>
+    TieredProgram<T> compileTiered(Operation<T> const& operation) {
+        return TieredProgram<T>(compile(operation));
+    }
+} // namespace calculator
+
+#endif //INCLUDE_TIERED_PROGRAM_H_
@@ -0,0 +1,120 @@
+#ifndef INCLUDE_PARALLEL_SUM_OPERATION_H_
+#define INCLUDE_PARALLEL_SUM_OPERATION_H_
+
+#include <algorithm>
+#include <concurrent/thread_pool.h>
+#include <memory>
+#include <operation/operation_operands.h>
+#include <operation/operation_transformer.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Wide sum whose operands are evaluated and whose values are added pairwise by the threads of the pool.
+     *
+     * The values are added in the same order as by the source sum so the results are the same whatever
+     * the number of threads is, for floating-point types only the operands are evaluated in parallel.
+     * Visitors are passed to the source operation so this one is transparent for them.
+     *
+     * @tparam T result of the operation
+     */
+    template<typename T>
+    class ParallelSumOperation final : public Operation<T> {
+        std::shared_ptr<VectorSumOperation<T>> const source_;
+        ThreadPool& pool_;
+
+        // operands evaluated or pairs of values added by a single task
+        static constexpr size_t GRAIN = 16;
+
+    public:
+        explicit ParallelSumOperation(std::shared_ptr<VectorSumOperation<T>> source,
+                                      ThreadPool& pool = ThreadPool::shared()) noexcept
+            : source_(std::move(source)), pool_(pool) {}
+
+        std::shared_ptr<VectorSumOperation<T>> const& source() const noexcept { return source_; }
+
+        T result(Variables<T> const& variables) const override {
+            auto const& operands = source_->operands();
+            auto const count = operands.size();
+            if (count < VectorSumOperation<T>::pairwiseThreshold()) return source_->result(variables);
+
+            std::vector<T> values(count);
+            pool_.parallelFor(count, GRAIN, [&](size_t const begin, size_t const end) {
+                for (auto i = begin; i < end; ++i) values[i] = operands[i]->result(variables);
+            });
+
+            // double-precision additions are too cheap to be split between the threads
+            if constexpr (std::is_floating_point_v<T>) return VectorSumOperation<T>::compute(values.data(), count);
+
+            // the additions of a level of `VectorSumOperation::compute` are independent
+            for (size_t stride = 1; stride < count; stride *= 2) {
+                auto const pairs = (count - stride + 2 * stride - 1) / (2 * stride);
+                pool_.parallelFor(pairs, GRAIN, [&values, stride](size_t const begin, size_t const end) {
+                    for (auto pair = begin; pair < end; ++pair) {
+                        auto const i = pair * 2 * stride;
+                        values[i] += values[i + stride];
+                    }
+                });
+            }
+
+            return std::move(values[0]);
+        }
+
+        void accept(OperationVisitor<T>& visitor) const override { source_->accept(visitor); }
+    };
+
+    /**
+     * @brief Transformer wrapping the wide sums whose operands are worth the threads into parallel ones.
+     *
+     * Every operand is worth them for exact types. Double-precision operands are only worth them
+     * if some of them are not leaves since a sum of variables and constants is faster to add up in place.
+     *
+     * @tparam T result of the transformed operations
+     */
+    template<typename T>
+    class OperationParallelizer final : public OperationTransformer<T> {
+        typedef typename OperationTransformer<T>::OperationPointer OperationPointer;
+
+        size_t parallelized_ = 0;
+
+        static bool isExpensive(VectorSumOperation<T> const& sum) {
+            auto const& operands = sum.operands();
+            if (operands.size() < VectorSumOperation<T>::pairwiseThreshold()) return false;
+            if constexpr (!std::is_floating_point_v<T>) return true;
+            else
+                return std::any_of(operands.begin(), operands.end(),
+                                   [](OperationPointer const& operand) { return !operandsOf(*operand).empty(); });
+        }
+
+    protected:
+        OperationPointer transformed(OperationPointer const& operation, OperationPointer const& parent,
+                                     OperationPointer&& result) override {
+            auto sum = std::dynamic_pointer_cast<VectorSumOperation<T>>(result);
+            if (!sum || !isExpensive(*sum)) return std::move(result);
+
+            ++parallelized_;
+            return std::make_shared<ParallelSumOperation<T>>(std::move(sum));
+        }
+
+    public:
+        /**
+         * @brief Gets the number of the sums which have been made parallel.
+         */
+        size_t parallelized() const noexcept { return parallelized_; }
+    };
+
+    /**
+     * @brief Makes the wide sums of the operation whose operands are worth the threads evaluated in parallel.
+     *
+     * Sums are wide if they have at least `VectorSumOperation<T>::pairwiseThreshold()` operands.
+     */
+    template<typename T>
+    std::shared_ptr<Operation<T>> parallelize(std::shared_ptr<Operation<T>> const& operation) {
+        return OperationParallelizer<T>().transform(operation);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_PARALLEL_SUM_OPERATION_H_
@@ -0,0 +1,183 @@
+#ifndef INCLUDE_THREAD_POOL_H_
+#define INCLUDE_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Pool of threads each having its own queue of tasks and stealing tasks of the others when it has none.
+     *
+     * Threads waiting for their tasks to complete run pending tasks meanwhile so that tasks may wait
+     * for their own sub-tasks with no risk of a deadlock.
+     */
+    class ThreadPool final {
+        typedef std::function<void()> Task;
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues_; // one per worker
+        std::vector<std::thread> workers_;
+        std::atomic<size_t> pending_{0}, nextQueue_{0};
+        std::mutex sleepMutex_;
+        std::condition_variable wakeUp_;
+        bool stopped_ = false;
+
+        struct Worker {
+            ThreadPool const* pool;
+            size_t index;
+        };
+
+        static Worker& currentWorker() noexcept {
+            thread_local Worker worker{nullptr, 0};
+            return worker;
+        }
+
+        // index of the queue of the current thread if it is a worker of this pool or `SIZE_MAX` otherwise
+        size_t workerIndex() const noexcept {
+            auto const& worker = currentWorker();
+            return worker.pool == this ? worker.index : SIZE_MAX;
+        }
+
+        void push(Task&& task) {
+            auto index = workerIndex();
+            if (index == SIZE_MAX) index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+            {
+                auto& queue = *queues_[index];
+                std::lock_guard lock(queue.mutex);
+                queue.tasks.push_back(std::move(task));
+            }
+            pending_.fetch_add(1, std::memory_order_release);
+            {
+                std::lock_guard lock(sleepMutex_); // so that a worker going to sleep doesn't miss the notification
+            }
+            wakeUp_.notify_one();
+        }
+
+        // takes the newest task of the own queue or the oldest task of another one
+        bool tryTake(size_t const own, Task& task) {
+            auto const count = queues_.size(), first = own == SIZE_MAX ? 0 : own;
+            for (size_t i = 0; i < count; ++i) {
+                auto& queue = *queues_[(first + i) % count];
+                std::lock_guard lock(queue.mutex);
+                if (queue.tasks.empty()) continue;
+
+                if (i == 0 && own != SIZE_MAX) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            return false;
+        }
+
+        bool tryRunPending() {
+            Task task;
+            if (!tryTake(workerIndex(), task)) return false;
+
+            task();
+            return true;
+        }
+
+        void work(size_t const index) {
+            currentWorker() = {this, index};
+            while (true) {
+                if (tryRunPending()) continue;
+
+                std::unique_lock lock(sleepMutex_);
+                wakeUp_.wait(lock, [this] { return stopped_ || pending_.load(std::memory_order_acquire) != 0; });
+                if (stopped_ && pending_.load(std::memory_order_acquire) == 0) return;
+            }
+        }
+
+    public:
+        /**
+         * @param threads number of worker threads
+         */
+        explicit ThreadPool(size_t const threads = std::max(1u, std::thread::hardware_concurrency())) {
+            for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) queues_.push_back(std::make_unique<Queue>());
+            for (size_t i = 0; i < queues_.size(); ++i) workers_.emplace_back([this, i] { work(i); });
+        }
+
+        ThreadPool(ThreadPool const&) = delete;
+
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(sleepMutex_);
+                stopped_ = true;
+            }
+            wakeUp_.notify_all();
+            for (auto& worker : workers_) worker.join();
+        }
+
+        size_t size() const noexcept { return workers_.size(); }
+
+        /**
+         * @brief Gets the pool shared by the whole process which has a thread per hardware thread.
+         */
+        static ThreadPool& shared() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Calls the body for each index of `[0, count)` splitting them into tasks of at least `grain` indices.
+         *
+         * The calling thread also takes part in the work and the call returns once all the indices are processed.
+         *
+         * @param body function called for a range `[begin, end)` of indices
+         * @throws the first exception thrown by the body (the remaining ranges are still processed)
+         */
+        template<typename F>
+        void parallelFor(size_t const count, size_t const grain, F&& body) {
+            if (count == 0) return;
+
+            // a few tasks per thread so that stealing can balance unequal ranges
+            auto const tasks = std::min(std::max<size_t>(count / std::max<size_t>(grain, 1), 1), size() * 4);
+            if (tasks == 1) return body(size_t(0), count);
+
+            std::atomic<size_t> remaining(tasks);
+            std::exception_ptr error;
+            std::mutex errorMutex;
+            auto const run = [&](size_t const task) {
+                try {
+                    body(count * task / tasks, count * (task + 1) / tasks);
+                } catch (...) {
+                    std::lock_guard lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                }
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            };
+
+            for (size_t task = 1; task < tasks; ++task) push([&run, task] { run(task); });
+            run(0);
+            while (remaining.load(std::memory_order_acquire) != 0)
+                if (!tryRunPending()) std::this_thread::yield();
+
+            if (error) std::rethrow_exception(error);
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_THREAD_POOL_H_
@@ -0,0 +1,78 @@
+#ifndef INCLUDE_JIT_OPERATION_H_
+#define INCLUDE_JIT_OPERATION_H_
+
+#include <atomic>
+#include <bytecode/program_compiler.h>
+#include <cstdint>
+#include <exception>
+#include <jit/native_compiler.h>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Double-precision operation evaluated by its interpreted program until it has been evaluated
+     * `threshold` times and by the native code of the program after that.
+     *
+     * The native code is compiled by the thread performing the evaluation number `threshold`
+     * while the other threads keep interpreting the program. If it can't be compiled (e.g. there is no compiler)
+     * the program is interpreted forever. Visitors are passed to the source operation.
+     */
+    class JitOperation final : public Operation<double> {
+        std::shared_ptr<Operation<double>> const source_;
+        Program<double> const program_;
+        NativeCompiler const compiler_;
+        uint64_t const threshold_;
+        mutable std::atomic<uint64_t> evaluations_{0};
+        mutable std::optional<NativeFunction> function_; // written once before `native_` is set
+        mutable std::atomic<NativeFunction const*> native_{nullptr};
+
+        void tierUp() const {
+            try {
+                function_.emplace(compiler_.compile(program_));
+                native_.store(&*function_, std::memory_order_release);
+            } catch (std::exception const&) {
+                // the interpreter stays
+            }
+        }
+
+    public:
+        // compiling takes tens of milliseconds, that is about a million of interpreted evaluations
+        static constexpr uint64_t DEFAULT_THRESHOLD = 1u << 20;
+
+        /**
+         * @param threshold number of the interpreted evaluations, the code is compiled immediately if it is zero
+         */
+        explicit JitOperation(std::shared_ptr<Operation<double>> source, uint64_t const threshold = DEFAULT_THRESHOLD,
+                              NativeCompiler compiler = NativeCompiler())
+            : source_(std::move(source)), program_(compile(*source_)), compiler_(std::move(compiler)),
+              threshold_(threshold) {
+            if (threshold_ == 0) tierUp();
+        }
+
+        std::shared_ptr<Operation<double>> const& source() const noexcept { return source_; }
+
+        Program<double> const& program() const noexcept { return program_; }
+
+        /**
+         * @brief Checks whether the operation is evaluated by the native code.
+         */
+        bool native() const noexcept { return native_.load(std::memory_order_acquire) != nullptr; }
+
+        double result(Variables<double> const& variables) const override {
+            if (auto const native = native_.load(std::memory_order_acquire)) return native->result(variables);
+            if (evaluations_.fetch_add(1, std::memory_order_relaxed) + 1 == threshold_) {
+                tierUp();
+                if (auto const native = native_.load(std::memory_order_acquire)) return native->result(variables);
+            }
+
+            return program_.result(variables);
+        }
+
+        void accept(OperationVisitor<double>& visitor) const override { source_->accept(visitor); }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_JIT_OPERATION_H_
@@ -0,0 +1,292 @@
+#ifndef INCLUDE_NATIVE_COMPILER_H_
+#define INCLUDE_NATIVE_COMPILER_H_
+
+#include <bytecode/program.h>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <spawn.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+extern char** environ;
+
+namespace calculator {
+
+    /**
+     * @brief Native code of a double-precision program loaded from a shared library.
+     *
+     * Its results and errors are those of the program, the library is unloaded with the last copy of it.
+     */
+    class NativeFunction final {
+    public:
+        // returns `SUCCESS`, `DIVISION_BY_ZERO` or `UNKNOWN_VARIABLE` plus the slot of the variable
+        typedef int (*Entry)(double const* variables, uint64_t bound, double* result);
+
+        static constexpr int SUCCESS = 0, DIVISION_BY_ZERO = 1, UNKNOWN_VARIABLE = 2;
+
+    private:
+        std::shared_ptr<void> library_;
+        Entry entry_;
+
+    public:
+        NativeFunction(std::shared_ptr<void> library, Entry const entry) noexcept
+            : library_(std::move(library)), entry_(entry) {}
+
+        double result(Variables<double> const& variables) const {
+            double result;
+            auto const status = entry_(variables.values().data(), variables.bound(), &result);
+            if (status == SUCCESS) return result;
+            if (status == DIVISION_BY_ZERO) throw OperationError("Division by zero");
+
+            throw OperationError("Unknown variable: "
+                                 + std::string(1, Variables<double>::nameOf(size_t(status - UNKNOWN_VARIABLE))));
+        }
+    };
+
+    /**
+     * @brief Compiler of double-precision programs into native code by the C compiler installed in the system.
+     *
+     * A program is translated into a C function computing its instructions in the same order by the same
+     * functions of the C library with no contraction of floating-point operations, so its results are those
+     * of the interpreted program. The compiler is `$CALCULATOR_CC`, `$CC` or `cc`, it is run with no shell.
+     */
+    class NativeCompiler final {
+        static constexpr char const* ENTRY = "calculator_expression";
+
+        std::string compiler_;
+
+        // removes the files of a compilation once the library is loaded, its mapping stays valid
+        class TemporaryDirectory final {
+            std::filesystem::path path_;
+
+        public:
+            TemporaryDirectory() {
+                auto pattern = (std::filesystem::temp_directory_path() / "calculator-jit-XXXXXX").string();
+                if (!::mkdtemp(pattern.data()))
+                    throw std::system_error(errno, std::generic_category(), "Unable to create " + pattern);
+                path_ = pattern;
+            }
+
+            TemporaryDirectory(TemporaryDirectory const&) = delete;
+
+            TemporaryDirectory& operator=(TemporaryDirectory const&) = delete;
+
+            ~TemporaryDirectory() {
+                std::error_code error;
+                std::filesystem::remove_all(path_, error);
+            }
+
+            std::filesystem::path const& path() const noexcept { return path_; }
+        };
+
+        static std::string literal(double const value) {
+            if (std::isnan(value)) return "NAN";
+            if (std::isinf(value)) return value < 0 ? "-INFINITY" : "INFINITY";
+
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%a", value); // hexadecimal literals are exact
+            return buffer;
+        }
+
+        static char const* functionOf(OpCode const code) noexcept {
+            switch (code) {
+                case OpCode::POW: return "pow";
+                case OpCode::SQRT: return "sqrt";
+                case OpCode::SIN: return "sin";
+                case OpCode::COS: return "cos";
+                default: return "tan";
+            }
+        }
+
+        void run(std::vector<std::string> arguments, std::filesystem::path const& diagnostics) const {
+            std::vector<char*> argv;
+            for (auto& argument : arguments) argv.push_back(argument.data());
+            argv.push_back(nullptr);
+
+            posix_spawn_file_actions_t actions;
+            ::posix_spawn_file_actions_init(&actions);
+            ::posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, diagnostics.c_str(),
+                                               O_WRONLY | O_CREAT | O_TRUNC, 0600);
+            ::posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+            pid_t process;
+            auto const error = ::posix_spawnp(&process, argv[0], &actions, nullptr, argv.data(), environ);
+            ::posix_spawn_file_actions_destroy(&actions);
+            if (error != 0) throw std::system_error(error, std::generic_category(), "Unable to run " + compiler_);
+
+            int status;
+            while (::waitpid(process, &status, 0) < 0)
+                if (errno != EINTR)
+                    throw std::system_error(errno, std::generic_category(), "Unable to wait for " + compiler_);
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0) return;
+
+            std::ifstream file(diagnostics);
+            throw std::runtime_error("Unable to compile the expression: "
+                                     + std::string(std::istreambuf_iterator<char>(file), {}));
+        }
+
+    public:
+        static std::string defaultCompiler() {
+            for (auto const variable : {"CALCULATOR_CC", "CC"})
+                if (auto const value = std::getenv(variable); value && *value) return value;
+
+            return "cc";
+        }
+
+        explicit NativeCompiler(std::string compiler = defaultCompiler()) : compiler_(std::move(compiler)) {}
+
+        /**
+         * @brief Translates the program into a C function `calculator_expression` of the type `NativeFunction::Entry`.
+         *
+         * Every instruction defines a new local value, so the stack and the temporaries of the program vanish.
+         */
+        static std::string source(Program<double> const& program) {
+            std::ostringstream code;
+            code << "#include <math.h>\n#include <stdint.h>\n\nint " << ENTRY
+                 << "(double const* const variables, uint64_t const bound, double* const result) {\n";
+
+            std::vector<std::string> stack, temporaries(program.temporaries());
+            size_t values = 0;
+            auto const define = [&](std::string const& expression) {
+                auto name = 'v' + std::to_string(values++);
+                code << "    double const " << name << " = " << expression << ";\n";
+                stack.push_back(std::move(name));
+            };
+            auto const pop = [&stack] {
+                auto value = std::move(stack.back());
+                stack.pop_back();
+                return value;
+            };
+
+            for (auto const& instruction : program.instructions()) {
+                switch (instruction.code) {
+                    case OpCode::CONSTANT: {
+                        define(literal(program.constants()[instruction.argument]));
+                        break;
+                    }
+                    case OpCode::VARIABLE: {
+                        auto const slot = std::to_string(instruction.argument);
+                        code << "    if ((bound >> " << slot << " & 1) == 0) return "
+                             << NativeFunction::UNKNOWN_VARIABLE + int(instruction.argument) << ";\n";
+                        define("variables[" + slot + ']');
+                        break;
+                    }
+                    case OpCode::LOAD: {
+                        stack.push_back(temporaries[instruction.argument]);
+                        break;
+                    }
+                    case OpCode::STORE: {
+                        temporaries[instruction.argument] = stack.back();
+                        break;
+                    }
+                    case OpCode::PLUS:
+                    case OpCode::MINUS:
+                    case OpCode::MULTIPLY: {
+                        auto const right = pop(), left = pop();
+                        auto const sign = instruction.code == OpCode::PLUS    ? " + "
+                                          : instruction.code == OpCode::MINUS ? " - "
+                                                                              : " * ";
+                        define(left + sign + right);
+                        break;
+                    }
+                    case OpCode::DIVIDE: {
+                        auto const right = pop(), left = pop();
+                        code << "    if (" << right << " == 0.0) return " << NativeFunction::DIVISION_BY_ZERO << ";\n";
+                        define(left + " / " + right);
+                        break;
+                    }
+                    case OpCode::NEGATIVE:
+                    case OpCode::INVERT: {
+                        define('-' + pop());
+                        break;
+                    }
+                    case OpCode::POW: {
+                        auto const right = pop(), left = pop();
+                        define(std::string("pow(") + left + ", " + right + ')');
+                        break;
+                    }
+                    case OpCode::SQRT:
+                    case OpCode::SIN:
+                    case OpCode::COS:
+                    case OpCode::TG: {
+                        define(std::string(functionOf(instruction.code)) + '(' + pop() + ')');
+                        break;
+                    }
+                    case OpCode::CTG: {
+                        define("1 / tan(" + pop() + ')');
+                        break;
+                    }
+                    case OpCode::SUM: {
+                        // the values are added up in the order of `VectorSumOperation::compute`
+                        auto const count = size_t(instruction.argument);
+                        auto const first = stack.end() - ptrdiff_t(count);
+                        auto const sum = 's' + std::to_string(values);
+                        if (count < VectorSumOperation<double>::pairwiseThreshold()) {
+                            code << "    double " << sum << " = 0.0;\n";
+                            for (auto value = first; value != stack.end(); ++value)
+                                code << "    " << sum << " += " << *value << ";\n";
+                        } else {
+                            code << "    double " << sum << '[' << count << "] = {";
+                            for (auto value = first; value != stack.end(); ++value)
+                                code << (value == first ? "" : ", ") << *value;
+                            code << "};\n    for (uint64_t stride = 1; stride < " << count << "; stride *= 2)\n"
+                                 << "        for (uint64_t i = 0; i + stride < " << count << "; i += 2 * stride) "
+                                 << sum << "[i] += " << sum << "[i + stride];\n";
+                        }
+                        stack.erase(first, stack.end());
+                        define(count < VectorSumOperation<double>::pairwiseThreshold() ? sum : sum + "[0]");
+                        break;
+                    }
+                }
+            }
+            code << "    *result = " << stack.back() << ";\n    return " << NativeFunction::SUCCESS << ";\n}\n";
+
+            return code.str();
+        }
+
+        /**
+         * @brief Compiles the program into native code and loads it.
+         *
+         * @throws std::runtime_error if the compiler is not available or fails
+         */
+        NativeFunction compile(Program<double> const& program) const {
+            TemporaryDirectory const directory;
+            auto const sourcePath = directory.path() / "expression.c", libraryPath = directory.path() / "expression.so";
+            {
+                std::ofstream file(sourcePath);
+                file << source(program);
+                if (!file.flush()) throw std::runtime_error("Unable to write " + sourcePath.string());
+            }
+            run({compiler_, "-std=c99", "-O2", "-fPIC", "-shared", "-ffp-contract=off", "-fno-math-errno", "-o",
+                 libraryPath.string(), sourcePath.string(), "-lm"},
+                directory.path() / "diagnostics.txt");
+
+            std::shared_ptr<void> library(::dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL),
+                                          [](void* const handle) {
+                                              if (handle) ::dlclose(handle);
+                                          });
+            if (!library) throw std::runtime_error(std::string("Unable to load the expression: ") + ::dlerror());
+            auto const entry = reinterpret_cast<NativeFunction::Entry>(::dlsym(library.get(), ENTRY));
+            if (!entry) throw std::runtime_error(std::string("Unable to find the expression: ") + ::dlerror());
+
+            return {std::move(library), entry};
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_NATIVE_COMPILER_H_
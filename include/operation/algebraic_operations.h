@@ -1,26 +1,63 @@
 #ifndef INCLUDE_ALGEBRAIC_OPERATIONS_H_
 #define INCLUDE_ALGEBRAIC_OPERATIONS_H_
 
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <operation/lazy_rational.h>
 #include <operation/operation.h>
+#include <operation/transcendental.h>
+#include <optional>
+#include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace calculator {
 
+    /**
+     * @brief Converts the value into a 64-bit integer if it is one.
+     *
+     * @tparam T floating-point or rational number type
+     */
+    template<typename T>
+    std::optional<int64_t> toInteger(T const& value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (value >= T(-0x1p63) && value < T(0x1p63) && value == std::trunc(value))
+                return static_cast<int64_t>(value);
+        } else if (denominator(value) == 1) {
+            auto const numeratorValue = numerator(value);
+            if (numeratorValue >= std::numeric_limits<int64_t>::min()
+                && numeratorValue <= std::numeric_limits<int64_t>::max())
+                return static_cast<int64_t>(numeratorValue);
+        }
+
+        return std::nullopt;
+    }
+
     template<typename T>
     class VariableOperation final : public Operation<T> {
-        char name_;
+        size_t slot_;
 
     public:
-        VariableOperation(char const name) noexcept : name_(name) {}
+        VariableOperation(char const name) : slot_(Variables<T>::slotOf(name)) {
+            if (!Variables<T>::isName(name)) throw OperationError("Invalid variable name: " + std::string(1, name));
+        }
 
-        T result(Variables<T> const& variables) const final override {
-            auto const variable = variables.get(name_);
-            if (variable) return variable.value();
-            throw new OperationError("Unknown variable: " + std::to_string(name_));
-        };
+        T result(Variables<T> const& variables) const final override { return compute(variables, slot_); };
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        char name() const noexcept { return Variables<T>::nameOf(slot_); }
+
+        size_t slot() const noexcept { return slot_; }
+
+        static T const& compute(Variables<T> const& variables, size_t const slot) {
+            if (auto const value = variables.find(slot)) return *value;
+            throw OperationError("Unknown variable: " + std::string(1, Variables<T>::nameOf(slot)));
+        }
     };
 
     template<typename T>
@@ -29,7 +66,11 @@ namespace calculator {
         PlusOperation(std::shared_ptr<Operation<T>> left, std::shared_ptr<Operation<T>> right) noexcept
             : BinaryOperation<T>(left, right) {}
 
-        T apply(T&& leftValue, T&& rightValue) const override { return leftValue + rightValue; }
+        T apply(T&& leftValue, T&& rightValue) const override { return compute(leftValue, rightValue); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& leftValue, T const& rightValue) { return leftValue + rightValue; }
     };
 
     template<typename T>
@@ -37,7 +78,11 @@ namespace calculator {
     public:
         NegativeOperation(std::shared_ptr<Operation<T>> operand) noexcept : UnaryOperation<T>(operand) {}
 
-        T apply(T&& value) const override { return -value; }
+        T apply(T&& value) const override { return compute(value); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& value) { return -value; }
     };
 
     template<typename T>
@@ -46,7 +91,11 @@ namespace calculator {
         MinusOperation(std::shared_ptr<Operation<T>> left, std::shared_ptr<Operation<T>> right) noexcept
             : BinaryOperation<T>(left, right) {}
 
-        T apply(T&& leftValue, T&& rightValue) const override { return leftValue - rightValue; }
+        T apply(T&& leftValue, T&& rightValue) const override { return compute(leftValue, rightValue); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& leftValue, T const& rightValue) { return leftValue - rightValue; }
     };
 
     template<typename T>
@@ -55,19 +104,25 @@ namespace calculator {
         MultiplyOperation(std::shared_ptr<Operation<T>> left, std::shared_ptr<Operation<T>> right) noexcept
             : BinaryOperation<T>(left, right) {}
 
-        T apply(T&& leftValue, T&& rightValue) const override { return leftValue * rightValue; }
+        T apply(T&& leftValue, T&& rightValue) const override { return compute(leftValue, rightValue); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& leftValue, T const& rightValue) { return leftValue * rightValue; }
     };
 
     template<typename T>
     class DivideOperation final : public BinaryOperation<T> {
-        T const ZERO{};
-
     public:
         DivideOperation(std::shared_ptr<Operation<T>> left, std::shared_ptr<Operation<T>> right) noexcept
             : BinaryOperation<T>(left, right) {}
 
-        T apply(T&& leftValue, T&& rightValue) const override {
-            if (rightValue == ZERO) throw OperationError("Division by zero");
+        T apply(T&& leftValue, T&& rightValue) const override { return compute(leftValue, rightValue); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& leftValue, T const& rightValue) {
+            if (rightValue == T{}) throw OperationError("Division by zero");
 
             return leftValue / rightValue;
         }
@@ -78,7 +133,11 @@ namespace calculator {
     public:
         InvertOperation(std::shared_ptr<Operation<T>> operand) noexcept : UnaryOperation<T>(operand) {}
 
-        T apply(T&& value) const override { return -value; }
+        T apply(T&& value) const override { return compute(value); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& value) { return -value; }
     };
 
     template<typename T>
@@ -87,9 +146,50 @@ namespace calculator {
         PowOperation(std::shared_ptr<Operation<T>> left, std::shared_ptr<Operation<T>> right) noexcept
             : BinaryOperation<T>(left, right) {}
 
-        T apply(T&& leftValue, T&& rightValue) const override {
+        T apply(T&& leftValue, T&& rightValue) const override { return compute(leftValue, rightValue); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& leftValue, T const& rightValue) {
+            if constexpr (!std::is_floating_point_v<T>) {
+                if (auto const exponent = toInteger(rightValue)) return compute(leftValue, *exponent);
+            }
+
             return static_cast<T>(pow(static_cast<double>(leftValue), static_cast<double>(rightValue)));
         }
+
+        // bound of the bits of the numerator and the denominator of an exact power, larger ones take too long
+        static constexpr uint64_t MAX_POWER_BITS = uint64_t(1) << 18;
+
+        /**
+         * @brief Raises the base to the integer power exactly by squaring it.
+         *
+         * @throws OperationError if the result of an exact type would have more than `MAX_POWER_BITS` bits
+         */
+        static T compute(T base, int64_t const exponent) {
+            auto magnitude = exponent < 0 ? 0 - static_cast<uint64_t>(exponent) : static_cast<uint64_t>(exponent);
+            if (magnitude == 0) return T(1);
+            if constexpr (!std::is_floating_point_v<T>) {
+                auto const numeratorValue = abs(numerator(base));
+                auto const denominatorValue = denominator(base);
+                if (numeratorValue > 1 || denominatorValue > 1) { // a zero is 0/1
+                    uint64_t const bits = std::max(msb(numeratorValue), msb(denominatorValue)) + 1;
+                    if (bits > MAX_POWER_BITS / magnitude)
+                        throw OperationError("The power is too large to be computed");
+                }
+            }
+            T result(1);
+            while (true) {
+                if ((magnitude & 1) != 0) result *= base;
+                magnitude >>= 1;
+                if (magnitude == 0) break;
+                base *= base;
+            }
+            if (exponent >= 0) return result;
+
+            if (result == T{}) throw OperationError("Division by zero");
+            return T(1) / result;
+        }
     };
 
     template<typename T>
@@ -97,22 +197,87 @@ namespace calculator {
     public:
         PrimitiveSqrtOperation(std::shared_ptr<Operation<T>> operand) noexcept : UnaryOperation<T>(operand) {}
 
-        T apply(T&& value) const override { return static_cast<T>(sqrt(static_cast<double>(value))); }
+        T apply(T&& value) const override { return compute(value); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& value) {
+            if constexpr (std::is_floating_point_v<T>) return sqrt(value);
+            else return Transcendental<T>::sqrt(value);
+        }
     };
 
+    /**
+     * @brief Sum of any number of operations.
+     *
+     * Sums of at least `pairwiseThreshold()` operands are wide: their values are added pairwise
+     * so that all the partial sums have similar sizes (which is what keeps numerators and denominators
+     * of rational sums small). Narrower sums of rationals are accumulated with no reduction of each partial sum.
+     * Wide sums are evaluated by a single thread, `ParallelSumOperation` evaluates them by the thread pool.
+     */
     template<typename T>
     class VectorSumOperation final : public Operation<T> {
         std::vector<std::shared_ptr<Operation<T>>> operands_;
 
+        static inline std::atomic<size_t> pairwiseThreshold_{1024};
+
     public:
-        VectorSumOperation(std::vector<std::shared_ptr<Operation<T>>> operands) noexcept : operands_(operands) {}
+        VectorSumOperation(std::vector<std::shared_ptr<Operation<T>>> operands) noexcept
+            : operands_(std::move(operands)) {}
 
         T result(Variables<T> const& variables) const final override {
-            T sum{};
-            for (auto const element : operands_) sum += element->result(variables);
+            auto const count = operands_.size();
+            if (count < pairwiseThreshold()) {
+                typename SumAccumulator<T>::type sum{};
+                for (auto const& element : operands_) sum += element->result(variables);
 
-            return sum;
+                return SumAccumulator<T>::value(std::move(sum));
+            }
+
+            std::vector<T> values;
+            values.reserve(count);
+            for (auto const& element : operands_) values.push_back(element->result(variables));
+
+            return compute(values.data(), count);
         };
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        std::vector<std::shared_ptr<Operation<T>>> const& operands() const noexcept { return operands_; }
+
+        /**
+         * @brief Gets the minimal number of operands of a wide sum.
+         */
+        static size_t pairwiseThreshold() noexcept { return pairwiseThreshold_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Sets the minimal number of operands of a wide sum.
+         */
+        static void setPairwiseThreshold(size_t const threshold) noexcept {
+            pairwiseThreshold_.store(threshold, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Adds up the given values in the same order as a sum of operations with these values does.
+         *
+         * @param values values which are overwritten by partial sums
+         * @param count number of the values
+         * @return sum of the values
+         */
+        static T compute(T* const values, size_t const count) {
+            if (count < pairwiseThreshold()) {
+                typename SumAccumulator<T>::type sum{};
+                for (auto value = values; value != values + count; ++value) sum += *value;
+
+                return SumAccumulator<T>::value(std::move(sum));
+            }
+
+            // each level adds the value at `i + stride` to the one at `i`
+            for (size_t stride = 1; stride < count; stride *= 2)
+                for (size_t i = 0; i + stride < count; i += 2 * stride) values[i] += values[i + stride];
+
+            return std::move(values[0]);
+        }
     };
 
     /*
@@ -123,7 +288,14 @@ namespace calculator {
     public:
         SinOperation(std::shared_ptr<Operation<T>> operand) noexcept : UnaryOperation<T>(operand) {}
 
-        T apply(T&& value) const override { return static_cast<T>(sin(static_cast<double>(value))); }
+        T apply(T&& value) const override { return compute(value); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& value) {
+            if constexpr (std::is_floating_point_v<T>) return sin(value);
+            else return Transcendental<T>::sin(value);
+        }
     };
 
     template<typename T>
@@ -131,7 +303,14 @@ namespace calculator {
     public:
         CosOperation(std::shared_ptr<Operation<T>> operand) noexcept : UnaryOperation<T>(operand) {}
 
-        T apply(T&& value) const override { return static_cast<T>(cos(static_cast<double>(value))); }
+        T apply(T&& value) const override { return compute(value); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& value) {
+            if constexpr (std::is_floating_point_v<T>) return cos(value);
+            else return Transcendental<T>::cos(value);
+        }
     };
 
     template<typename T>
@@ -139,7 +318,14 @@ namespace calculator {
     public:
         TgOperation(std::shared_ptr<Operation<T>> operand) noexcept : UnaryOperation<T>(operand) {}
 
-        T apply(T&& value) const override { return static_cast<T>(tan(static_cast<double>(value))); }
+        T apply(T&& value) const override { return compute(value); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& value) {
+            if constexpr (std::is_floating_point_v<T>) return tan(value);
+            else return Transcendental<T>::tg(value);
+        }
     };
 
     template<typename T>
@@ -147,7 +333,14 @@ namespace calculator {
     public:
         CtgOperation(std::shared_ptr<Operation<T>> operand) noexcept : UnaryOperation<T>(operand) {}
 
-        T apply(T&& value) const override { return static_cast<T>(1. / tan(static_cast<double>(value))); }
+        T apply(T&& value) const override { return compute(value); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute(T const& value) {
+            if constexpr (std::is_floating_point_v<T>) return 1 / tan(value);
+            else return Transcendental<T>::ctg(value);
+        }
     };
 } // namespace calculator
 
@@ -3,6 +3,8 @@
 
 #include <cmath>
 #include <operation/operation.h>
+#include <operation/transcendental.h>
+#include <type_traits>
 #include <utility>
 
 namespace calculator {
@@ -17,6 +19,10 @@ namespace calculator {
         explicit ConstOperation(T&& result) noexcept : result_(std::move(result)) {}
 
         T result(Variables<T> const& variables) const override { return result_; }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        T const& value() const noexcept { return result_; }
     };
 
     template<typename T>
@@ -27,7 +33,14 @@ namespace calculator {
 
         explicit ConstEOperation() {}
 
-        T result(Variables<T> const& variables)const override { return M_E; }
+        T result(Variables<T> const& variables)const override { return compute(); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute() {
+            if constexpr (std::is_floating_point_v<T>) return M_E;
+            else return Transcendental<T>::e();
+        }
     };
 
     template<typename T>
@@ -38,7 +51,14 @@ namespace calculator {
 
         explicit ConstPiOperation() {}
 
-        T result(Variables<T> const& variables)const override { return M_PI; }
+        T result(Variables<T> const& variables)const override { return compute(); }
+
+        void accept(OperationVisitor<T>& visitor) const override { visitor.visit(*this); }
+
+        static T compute() {
+            if constexpr (std::is_floating_point_v<T>) return M_PI;
+            else return Transcendental<T>::pi();
+        }
     };
 } // namespace calculator
 
@@ -0,0 +1,203 @@
+#ifndef INCLUDE_LAZY_RATIONAL_H_
+#define INCLUDE_LAZY_RATIONAL_H_
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cmath>
+#include <concepts>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace calculator {
+
+    template<typename T>
+    concept BoostRational = boost::multiprecision::number_category<T>::value
+                            == boost::multiprecision::number_kind_rational;
+
+    /**
+     * @brief Rational number which is reduced by the gcd of its numerator and denominator only when they grow big.
+     *
+     * Chains of arithmetic operations skip most of the gcd computations which dominate the cost of exact rationals,
+     * a value is reduced once its denominator exceeds `REDUCTION_BITS` bits (or doubles after a reduction)
+     * and when its parts are read.
+     * It can be used as the type of operations or as an accumulator of sums of another rational type.
+     *
+     * @tparam Integer arbitrary-precision integer type
+     */
+    template<typename Integer>
+    class LazyRational final {
+        Integer numerator_, denominator_; // the denominator is always positive
+        size_t reductionBits_ = REDUCTION_BITS;
+
+        void reduceIfBig() {
+            if (msb(denominator_) > reductionBits_) reduce();
+        }
+
+    public:
+        static constexpr size_t REDUCTION_BITS = 64;
+
+        LazyRational() : numerator_(0), denominator_(1) {}
+
+        template<std::integral I>
+        LazyRational(I const value) : numerator_(value), denominator_(1) {}
+
+        /**
+         * @throws std::domain_error if the value is not finite
+         */
+        explicit LazyRational(double const value) : numerator_(0), denominator_(1) {
+            if (!std::isfinite(value)) throw std::domain_error("Not a finite number: " + std::to_string(value));
+
+            int exponent;
+            auto const mantissa = std::frexp(value, &exponent); // value = mantissa * 2^exponent
+            numerator_ = Integer(static_cast<long long>(std::ldexp(mantissa, 53)));
+            exponent -= 53;
+            if (exponent >= 0) numerator_ <<= exponent;
+            else denominator_ <<= -exponent;
+            reduce();
+        }
+
+        LazyRational(Integer numerator, Integer denominator)
+            : numerator_(std::move(numerator)), denominator_(std::move(denominator)) {
+            if (denominator_ == 0) throw std::domain_error("Zero denominator");
+            if (denominator_ < 0) {
+                numerator_ = -numerator_;
+                denominator_ = -denominator_;
+            }
+        }
+
+        template<BoostRational R>
+        LazyRational(R const& value) : numerator_(numerator(value)), denominator_(denominator(value)) {}
+
+        /**
+         * @brief Gets the value as another rational type.
+         */
+        template<BoostRational R>
+        R to() const {
+            return R(numerator_, denominator_);
+        }
+
+        explicit operator double() const {
+            return to<boost::multiprecision::cpp_rational>().template convert_to<double>();
+        }
+
+        /**
+         * @brief Divides the numerator and the denominator by their gcd.
+         */
+        LazyRational& reduce() {
+            Integer const divisor = gcd(numerator_, denominator_);
+            if (divisor != 1) {
+                numerator_ /= divisor;
+                denominator_ /= divisor;
+            }
+            // a value which stays big after a reduction is not reduced again until it doubles
+            reductionBits_ = std::max<size_t>(REDUCTION_BITS, 2 * msb(denominator_));
+
+            return *this;
+        }
+
+        friend Integer numerator(LazyRational value) { return std::move(value.reduce().numerator_); }
+
+        friend Integer denominator(LazyRational value) { return std::move(value.reduce().denominator_); }
+
+        LazyRational operator-() const {
+            auto negated = *this;
+            negated.numerator_ = -negated.numerator_;
+            return negated;
+        }
+
+        LazyRational& operator+=(LazyRational const& other) {
+            if (denominator_ == other.denominator_) numerator_ += other.numerator_;
+            else {
+                numerator_ = numerator_ * other.denominator_ + other.numerator_ * denominator_;
+                denominator_ *= other.denominator_;
+                reduceIfBig();
+            }
+
+            return *this;
+        }
+
+        LazyRational& operator-=(LazyRational const& other) { return *this += -other; }
+
+        LazyRational& operator*=(LazyRational const& other) {
+            numerator_ *= other.numerator_;
+            denominator_ *= other.denominator_;
+            reduceIfBig();
+
+            return *this;
+        }
+
+        /**
+         * @throws std::domain_error if the other value is zero
+         */
+        LazyRational& operator/=(LazyRational const& other) {
+            if (other.numerator_ == 0) throw std::domain_error("Division by zero");
+
+            numerator_ *= other.denominator_;
+            denominator_ *= other.numerator_;
+            if (denominator_ < 0) {
+                numerator_ = -numerator_;
+                denominator_ = -denominator_;
+            }
+            reduceIfBig();
+
+            return *this;
+        }
+
+        friend LazyRational operator+(LazyRational left, LazyRational const& right) { return left += right; }
+
+        friend LazyRational operator-(LazyRational left, LazyRational const& right) { return left -= right; }
+
+        friend LazyRational operator*(LazyRational left, LazyRational const& right) { return left *= right; }
+
+        friend LazyRational operator/(LazyRational left, LazyRational const& right) { return left /= right; }
+
+        friend bool operator==(LazyRational const& left, LazyRational const& right) {
+            return left.numerator_ * right.denominator_ == right.numerator_ * left.denominator_;
+        }
+
+        friend bool operator<(LazyRational const& left, LazyRational const& right) {
+            return left.numerator_ * right.denominator_ < right.numerator_ * left.denominator_;
+        }
+
+        friend bool operator>(LazyRational const& left, LazyRational const& right) { return right < left; }
+
+        friend bool operator<=(LazyRational const& left, LazyRational const& right) { return !(right < left); }
+
+        friend bool operator>=(LazyRational const& left, LazyRational const& right) { return !(left < right); }
+
+        std::string str() const {
+            auto reduced = *this;
+            reduced.reduce();
+            return reduced.denominator_ == 1 ? reduced.numerator_.str()
+                                             : reduced.numerator_.str() + '/' + reduced.denominator_.str();
+        }
+
+        friend std::ostream& operator<<(std::ostream& output, LazyRational const& value) {
+            return output << value.str();
+        }
+    };
+
+    typedef LazyRational<boost::multiprecision::cpp_int> LazyBigRational;
+
+    /**
+     * @brief Type in which sums of values are accumulated.
+     *
+     * Rationals of Boost.Multiprecision are summed up as lazy ones so that the terms are not reduced one by one.
+     */
+    template<typename T>
+    struct SumAccumulator {
+        typedef T type;
+
+        static T value(type&& sum) { return std::move(sum); }
+    };
+
+    template<BoostRational T>
+    struct SumAccumulator<T> {
+        typedef LazyRational<typename boost::multiprecision::component_type<T>::type> type;
+
+        static T value(type&& sum) { return sum.template to<T>(); }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_LAZY_RATIONAL_H_
@@ -0,0 +1,111 @@
+#ifndef INCLUDE_MEMOIZED_OPERATION_H_
+#define INCLUDE_MEMOIZED_OPERATION_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <operation/operation_dependencies.h>
+#include <operation/operation_transformer.h>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Operation remembering its last result together with the values of the variables it depends on.
+     *
+     * The result is computed again only when some of these values change. When several threads evaluate
+     * the operation at once only one of them uses the remembered result, the others compute it.
+     * Visitors are passed to the source operation so this one is transparent for them.
+     *
+     * @tparam T result of the operation
+     */
+    template<typename T>
+    class MemoizedOperation final : public Operation<T> {
+        std::shared_ptr<Operation<T>> const source_;
+        uint64_t const dependencies_;
+        std::vector<size_t> slots_;
+
+        mutable std::mutex mutex_;
+        mutable std::vector<T> inputs_; // values of the variables of `slots_` for the remembered result
+        mutable std::optional<T> result_;
+
+        bool hasInputs(Variables<T> const& variables) const {
+            for (size_t i = 0; i < slots_.size(); ++i) {
+                auto const value = variables.find(slots_[i]);
+                if (!value || !(*value == inputs_[i])) return false;
+            }
+
+            return true;
+        }
+
+    public:
+        /**
+         * @param source memoized operation
+         * @param dependencies mask of the slots of the variables on which the source operation depends
+         */
+        MemoizedOperation(std::shared_ptr<Operation<T>> source, uint64_t const dependencies)
+            : source_(std::move(source)), dependencies_(dependencies) {
+            for (size_t slot = 0; slot < Variables<T>::SLOTS; ++slot)
+                if ((dependencies >> slot & 1) != 0) slots_.push_back(slot);
+            inputs_.resize(slots_.size());
+        }
+
+        std::shared_ptr<Operation<T>> const& source() const noexcept { return source_; }
+
+        uint64_t dependencies() const noexcept { return dependencies_; }
+
+        T result(Variables<T> const& variables) const override {
+            std::unique_lock lock(mutex_, std::try_to_lock);
+            if (!lock) return source_->result(variables);
+            if (result_ && hasInputs(variables)) return *result_;
+
+            result_.reset();
+            auto result = source_->result(variables); // unknown variables throw here so they are never remembered
+            for (size_t i = 0; i < slots_.size(); ++i) inputs_[i] = *variables.find(slots_[i]);
+            result_ = result;
+
+            return result;
+        }
+
+        void accept(OperationVisitor<T>& visitor) const override { source_->accept(visitor); }
+    };
+
+    /**
+     * @brief Transformer wrapping the operations whose dependencies differ from those of their parents
+     * into memoized ones.
+     *
+     * Such an operation keeps its result while only the variables of its parent, which it doesn't depend on,
+     * change. The root is wrapped as well so that whole results are kept for repeated bindings.
+     *
+     * @tparam T result of the transformed operations
+     */
+    template<typename T>
+    class OperationMemoizer final : public OperationTransformer<T> {
+        typedef typename OperationTransformer<T>::OperationPointer OperationPointer;
+
+        DependencyAnalyzer<T> analyzer_;
+
+    protected:
+        OperationPointer transformed(OperationPointer const& operation, OperationPointer const& parent,
+                                     OperationPointer&& result) override {
+            if (operandsOf(*operation).empty()) return std::move(result); // leaves are as cheap as a lookup
+
+            auto const dependencies = analyzer_.dependencies(*operation);
+            if (parent && dependencies == analyzer_.dependencies(*parent)) return std::move(result);
+
+            return std::make_shared<MemoizedOperation<T>>(std::move(result), dependencies);
+        }
+    };
+
+    /**
+     * @brief Memoizes the subtrees of the operation which don't depend on all the variables of their parents.
+     */
+    template<typename T>
+    std::shared_ptr<Operation<T>> memoize(std::shared_ptr<Operation<T>> const& operation) {
+        return OperationMemoizer<T>().transform(operation);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_MEMOIZED_OPERATION_H_
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_OPERATION_H_
 #define INCLUDE_OPERATION_H_
 
+#include <memory>
+#include <operation/operation_visitor.h>
 #include <operation/variables.h>
 #include <stdexcept>
 #include <system_error>
@@ -34,6 +36,13 @@ namespace calculator {
          * @return result of this operation
          */
         virtual T result(Variables<T> const& variables) const = 0;
+
+        /**
+         * @brief Accepts the visitor calling its method specific to this operation.
+         *
+         * @param visitor visitor to accept
+         */
+        virtual void accept(OperationVisitor<T>& visitor) const = 0;
     };
 
     template<typename T>
@@ -45,6 +54,8 @@ namespace calculator {
 
         T result(Variables<T> const& variables) const final override { return apply(operand_->result(variables)); };
 
+        std::shared_ptr<Operation<T>> const& operand() const noexcept { return operand_; }
+
     protected:
         virtual T apply(T&& value) const = 0;
     };
@@ -62,6 +73,10 @@ namespace calculator {
             return apply(leftOperand_->result(variables), rightOperand_->result(variables));
         };
 
+        std::shared_ptr<Operation<T>> const& leftOperand() const noexcept { return leftOperand_; }
+
+        std::shared_ptr<Operation<T>> const& rightOperand() const noexcept { return rightOperand_; }
+
     protected:
         virtual T apply(T&& leftValue, T&& rightValue) const = 0;
     };
@@ -0,0 +1,45 @@
+#ifndef INCLUDE_OPERATION_DEPENDENCIES_H_
+#define INCLUDE_OPERATION_DEPENDENCIES_H_
+
+#include <cstdint>
+#include <operation/operation_operands.h>
+#include <unordered_map>
+
+namespace calculator {
+
+    /**
+     * @brief Analyzer of the variables on which operations depend.
+     *
+     * Dependencies are bit masks of variable slots (see `Variables::slotOf`).
+     * Each operation is analyzed only once so shared operations of DAGs cost nothing extra.
+     *
+     * @tparam T result of the analyzed operations
+     */
+    template<typename T>
+    class DependencyAnalyzer final {
+        std::unordered_map<Operation<T> const*, uint64_t> dependencies_;
+
+    public:
+        /**
+         * @brief Gets the mask of the slots of the variables on which the operation depends.
+         */
+        uint64_t dependencies(Operation<T> const& operation) {
+            if (auto const found = dependencies_.find(&operation); found != dependencies_.end()) return found->second;
+
+            uint64_t mask = 0;
+            if (auto const variable = dynamic_cast<VariableOperation<T> const*>(&operation))
+                mask = uint64_t(1) << variable->slot();
+            else
+                for (auto const& operand : operandsOf(operation)) mask |= dependencies(*operand);
+
+            return dependencies_[&operation] = mask;
+        }
+    };
+
+    template<typename T>
+    uint64_t dependenciesOf(Operation<T> const& operation) {
+        return DependencyAnalyzer<T>().dependencies(operation);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_OPERATION_DEPENDENCIES_H_
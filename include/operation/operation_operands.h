@@ -0,0 +1,79 @@
+#ifndef INCLUDE_OPERATION_OPERANDS_H_
+#define INCLUDE_OPERATION_OPERANDS_H_
+
+#include <memory>
+#include <operation/algebraic_operations.h>
+#include <operation/const_operation.h>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief A visitor collecting the direct operands of an operation.
+     *
+     * @tparam T result of the visited operations
+     */
+    template<typename T>
+    class OperandsCollector final : public OperationVisitor<T> {
+        std::vector<std::shared_ptr<Operation<T>>> operands_;
+
+        void collect(UnaryOperation<T> const& operation) { operands_.push_back(operation.operand()); }
+
+        void collect(BinaryOperation<T> const& operation) {
+            operands_.push_back(operation.leftOperand());
+            operands_.push_back(operation.rightOperand());
+        }
+
+    public:
+        static std::vector<std::shared_ptr<Operation<T>>> collect(Operation<T> const& operation) {
+            OperandsCollector collector;
+            operation.accept(collector);
+
+            return std::move(collector.operands_);
+        }
+
+        void visit(ConstOperation<T> const& operation) override {}
+
+        void visit(ConstEOperation<T> const& operation) override {}
+
+        void visit(ConstPiOperation<T> const& operation) override {}
+
+        void visit(VariableOperation<T> const& operation) override {}
+
+        void visit(PlusOperation<T> const& operation) override { collect(operation); }
+
+        void visit(NegativeOperation<T> const& operation) override { collect(operation); }
+
+        void visit(MinusOperation<T> const& operation) override { collect(operation); }
+
+        void visit(MultiplyOperation<T> const& operation) override { collect(operation); }
+
+        void visit(DivideOperation<T> const& operation) override { collect(operation); }
+
+        void visit(InvertOperation<T> const& operation) override { collect(operation); }
+
+        void visit(PowOperation<T> const& operation) override { collect(operation); }
+
+        void visit(PrimitiveSqrtOperation<T> const& operation) override { collect(operation); }
+
+        void visit(VectorSumOperation<T> const& operation) override { operands_ = operation.operands(); }
+
+        void visit(SinOperation<T> const& operation) override { collect(operation); }
+
+        void visit(CosOperation<T> const& operation) override { collect(operation); }
+
+        void visit(TgOperation<T> const& operation) override { collect(operation); }
+
+        void visit(CtgOperation<T> const& operation) override { collect(operation); }
+    };
+
+    /**
+     * @brief Gets the direct operands of the operation.
+     */
+    template<typename T>
+    std::vector<std::shared_ptr<Operation<T>>> operandsOf(Operation<T> const& operation) {
+        return OperandsCollector<T>::collect(operation);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_OPERATION_OPERANDS_H_
@@ -0,0 +1,137 @@
+#ifndef INCLUDE_OPERATION_TRANSFORMER_H_
+#define INCLUDE_OPERATION_TRANSFORMER_H_
+
+#include <memory>
+#include <operation/algebraic_operations.h>
+#include <operation/const_operation.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief A visitor building a transformed copy of an AST.
+     *
+     * By default every operation is kept as is unless some of its operands get transformed,
+     * in which case it is recreated with the transformed operands.
+     * Each operation is transformed only once so operations shared in the source DAG stay shared.
+     *
+     * @tparam T result of the transformed operations
+     */
+    template<typename T>
+    class OperationTransformer : public OperationVisitor<T> {
+    protected:
+        typedef std::shared_ptr<Operation<T>> OperationPointer;
+
+    private:
+        OperationPointer current_, result_;
+        std::unordered_map<Operation<T> const*, OperationPointer> transformed_;
+
+    public:
+        /**
+         * @brief Transforms the given operation.
+         *
+         * @param operation operation to transform
+         * @return transformed operation which may be the given one
+         */
+        OperationPointer transform(OperationPointer const& operation) {
+            if (auto const transformed = transformed_.find(operation.get()); transformed != transformed_.end())
+                return transformed->second;
+
+            auto const previous = std::exchange(current_, operation);
+            operation->accept(*this);
+            current_ = previous;
+
+            return transformed_[operation.get()] = transformed(operation, previous, std::move(result_));
+        }
+
+        void visit(ConstOperation<T> const& operation) override { keep(); }
+
+        void visit(ConstEOperation<T> const& operation) override { keep(); }
+
+        void visit(ConstPiOperation<T> const& operation) override { keep(); }
+
+        void visit(VariableOperation<T> const& operation) override { keep(); }
+
+        void visit(PlusOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(NegativeOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(MinusOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(MultiplyOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(DivideOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(InvertOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(PowOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(PrimitiveSqrtOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(VectorSumOperation<T> const& operation) override {
+            auto changed = false;
+            std::vector<OperationPointer> operands;
+            operands.reserve(operation.operands().size());
+            for (auto const& operand : operation.operands()) {
+                operands.push_back(transform(operand));
+                changed |= operands.back() != operand;
+            }
+
+            if (changed) replace(std::make_shared<VectorSumOperation<T>>(std::move(operands)));
+            else keep();
+        }
+
+        void visit(SinOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(CosOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(TgOperation<T> const& operation) override { rebuild(operation); }
+
+        void visit(CtgOperation<T> const& operation) override { rebuild(operation); }
+
+    protected:
+        /**
+         * @brief Gets the final result of transforming an operation, by default the one set by its visit.
+         *
+         * @param operation transformed operation
+         * @param parent operation whose operand is transformed or `nullptr` for the root
+         * @param result result set by the visit of the operation
+         */
+        virtual OperationPointer transformed(OperationPointer const& operation, OperationPointer const& parent,
+                                             OperationPointer&& result) {
+            return std::move(result);
+        }
+
+        /**
+         * @brief Gets the operation being currently visited.
+         */
+        OperationPointer const& current() const noexcept { return current_; }
+
+        /**
+         * @brief Sets the result of transforming the currently visited operation.
+         */
+        void replace(OperationPointer operation) noexcept { result_ = std::move(operation); }
+
+        /**
+         * @brief Leaves the currently visited operation as is.
+         */
+        void keep() { result_ = current_; }
+
+        template<typename O>
+        void rebuild(O const& operation) {
+            if constexpr (std::is_base_of_v<UnaryOperation<T>, O>) {
+                auto operand = transform(operation.operand());
+                if (operand == operation.operand()) keep();
+                else replace(std::make_shared<O>(std::move(operand)));
+            } else {
+                auto left = transform(operation.leftOperand()), right = transform(operation.rightOperand());
+                if (left == operation.leftOperand() && right == operation.rightOperand()) keep();
+                else replace(std::make_shared<O>(std::move(left), std::move(right)));
+            }
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_OPERATION_TRANSFORMER_H_
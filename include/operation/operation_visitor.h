@@ -0,0 +1,103 @@
+#ifndef INCLUDE_OPERATION_VISITOR_H_
+#define INCLUDE_OPERATION_VISITOR_H_
+
+namespace calculator {
+
+    template<typename T>
+    class ConstOperation;
+
+    template<typename T>
+    class ConstEOperation;
+
+    template<typename T>
+    class ConstPiOperation;
+
+    template<typename T>
+    class VariableOperation;
+
+    template<typename T>
+    class PlusOperation;
+
+    template<typename T>
+    class NegativeOperation;
+
+    template<typename T>
+    class MinusOperation;
+
+    template<typename T>
+    class MultiplyOperation;
+
+    template<typename T>
+    class DivideOperation;
+
+    template<typename T>
+    class InvertOperation;
+
+    template<typename T>
+    class PowOperation;
+
+    template<typename T>
+    class PrimitiveSqrtOperation;
+
+    template<typename T>
+    class VectorSumOperation;
+
+    template<typename T>
+    class SinOperation;
+
+    template<typename T>
+    class CosOperation;
+
+    template<typename T>
+    class TgOperation;
+
+    template<typename T>
+    class CtgOperation;
+
+    /**
+     * @brief A visitor of the concrete operations forming an AST.
+     *
+     * @tparam T result of the visited operations
+     */
+    template<typename T>
+    class OperationVisitor {
+    public:
+        virtual ~OperationVisitor() noexcept = default;
+
+        virtual void visit(ConstOperation<T> const& operation) = 0;
+
+        virtual void visit(ConstEOperation<T> const& operation) = 0;
+
+        virtual void visit(ConstPiOperation<T> const& operation) = 0;
+
+        virtual void visit(VariableOperation<T> const& operation) = 0;
+
+        virtual void visit(PlusOperation<T> const& operation) = 0;
+
+        virtual void visit(NegativeOperation<T> const& operation) = 0;
+
+        virtual void visit(MinusOperation<T> const& operation) = 0;
+
+        virtual void visit(MultiplyOperation<T> const& operation) = 0;
+
+        virtual void visit(DivideOperation<T> const& operation) = 0;
+
+        virtual void visit(InvertOperation<T> const& operation) = 0;
+
+        virtual void visit(PowOperation<T> const& operation) = 0;
+
+        virtual void visit(PrimitiveSqrtOperation<T> const& operation) = 0;
+
+        virtual void visit(VectorSumOperation<T> const& operation) = 0;
+
+        virtual void visit(SinOperation<T> const& operation) = 0;
+
+        virtual void visit(CosOperation<T> const& operation) = 0;
+
+        virtual void visit(TgOperation<T> const& operation) = 0;
+
+        virtual void visit(CtgOperation<T> const& operation) = 0;
+    };
+} // namespace calculator
+
+#endif //INCLUDE_OPERATION_VISITOR_H_
@@ -0,0 +1,86 @@
+#ifndef INCLUDE_STATIC_OPERATION_H_
+#define INCLUDE_STATIC_OPERATION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <operation/algebraic_operations.h>
+#include <operation/const_operation.h>
+#include <operation/lazy_rational.h>
+#include <type_traits>
+
+namespace calculator {
+
+    enum class StaticKind : uint8_t {
+        CONSTANT,
+        VARIABLE,
+        E,
+        PI,
+        PLUS,
+        MINUS,
+        MULTIPLY,
+        DIVIDE,
+        NEGATIVE,
+        POW,
+        SQRT,
+        SUM,
+        SIN,
+        COS,
+        TG,
+        CTG
+    };
+
+    /**
+     * @brief Operation whose whole tree is its type so that its evaluation is inlined with no virtual calls.
+     *
+     * Each kind of node computes its value by the same function as the corresponding operation of the AST.
+     *
+     * @tparam KIND kind of the node
+     * @tparam NUMERATOR numerator of the value of a constant
+     * @tparam DENOMINATOR denominator of the value of a constant
+     * @tparam SLOT slot of a variable
+     * @tparam Operands static operations of the operands
+     */
+    template<StaticKind KIND, uint64_t NUMERATOR, uint64_t DENOMINATOR, size_t SLOT, typename... Operands>
+    struct StaticOperation {
+        template<typename T>
+        static T result(Variables<T> const& variables) {
+            if constexpr (KIND == StaticKind::CONSTANT) return constant<T>();
+            else if constexpr (KIND == StaticKind::VARIABLE) return VariableOperation<T>::compute(variables, SLOT);
+            else if constexpr (KIND == StaticKind::E) return ConstEOperation<T>::compute();
+            else if constexpr (KIND == StaticKind::PI) return ConstPiOperation<T>::compute();
+            else if constexpr (KIND == StaticKind::SUM) {
+                typename SumAccumulator<T>::type sum{};
+                ((sum += Operands::template result<T>(variables)), ...);
+
+                return SumAccumulator<T>::value(std::move(sum));
+            } else return compute<T>(Operands::template result<T>(variables)...);
+        }
+
+    private:
+        template<typename T>
+        static T constant() {
+            if constexpr (std::is_floating_point_v<T>) return T(NUMERATOR) / T(DENOMINATOR);
+            else {
+                static T const value = T(NUMERATOR) / T(DENOMINATOR);
+                return value;
+            }
+        }
+
+        template<typename T, typename... A>
+        static T compute(A const&... values) {
+            if constexpr (KIND == StaticKind::PLUS) return PlusOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::MINUS) return MinusOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::MULTIPLY) return MultiplyOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::DIVIDE) return DivideOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::NEGATIVE) return NegativeOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::POW) return PowOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::SQRT) return PrimitiveSqrtOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::SIN) return SinOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::COS) return CosOperation<T>::compute(values...);
+            else if constexpr (KIND == StaticKind::TG) return TgOperation<T>::compute(values...);
+            else return CtgOperation<T>::compute(values...);
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_STATIC_OPERATION_H_
@@ -0,0 +1,285 @@
+#ifndef INCLUDE_TRANSCENDENTAL_H_
+#define INCLUDE_TRANSCENDENTAL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cstdint>
+#include <mutex>
+#include <operation/operation.h>
+#include <type_traits>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Number of significant decimal digits computed by the transcendental functions of exact types.
+     */
+    class Precision final {
+        static inline std::atomic<size_t> digits_{40};
+
+    public:
+        static size_t digits() noexcept { return digits_.load(std::memory_order_relaxed); }
+
+        static void setDigits(size_t const digits) noexcept {
+            digits_.store(std::max<size_t>(digits, 1), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the number of binary digits which is enough for the decimal ones.
+         */
+        static size_t bits() noexcept { return digits() * 3322 / 1000 + 2; }
+    };
+
+    /**
+     * @brief Transcendental functions of rational numbers computed to `Precision::digits()` digits.
+     *
+     * Values are computed in binary fixed point, i.e. as integers scaled by `2^bits`, with a few guard bits.
+     * Arguments of trigonometric functions are reduced to `[-pi/4, pi/4]` where Taylor series converge quickly
+     * and the series stop at the first term which is zero at the working precision
+     * so the cost grows with the number of requested digits.
+     *
+     * @tparam T rational number type whose parts are read by `numerator` and `denominator`
+     */
+    template<typename T>
+    class Transcendental final {
+        typedef std::decay_t<decltype(numerator(std::declval<T const&>()))> Integer;
+
+        static constexpr size_t GUARD_BITS = 32;
+
+        struct Cache {
+            std::mutex mutex;
+            size_t bits = 0;
+            Integer value;
+        };
+
+        static Integer one(size_t const bits) { return Integer(1) << bits; }
+
+        static Integer toFixed(T const& value, size_t const bits) {
+            return (Integer(numerator(value)) << bits) / Integer(denominator(value));
+        }
+
+        static T fromFixed(Integer const& value, size_t const bits) { return T(value, one(bits)); }
+
+        // ratio of fixed-point values (whose scales cancel out)
+        static T ratio(Integer const& dividend, Integer const& divisor) {
+            return divisor < 0 ? T(-dividend, -divisor) : T(dividend, divisor);
+        }
+
+        // number of bits by which the value is smaller than 1, used to keep the precision relative
+        static size_t smallness(T const& value) {
+            Integer const magnitude = abs(numerator(value));
+            if (magnitude == 0) return 0;
+
+            auto const numeratorBits = msb(magnitude), denominatorBits = msb(Integer(denominator(value)));
+            return denominatorBits > numeratorBits ? denominatorBits - numeratorBits : 0;
+        }
+
+        // number of bits of the integer part of the value
+        static size_t largeness(T const& value) {
+            Integer const integer = abs(numerator(value)) / Integer(denominator(value));
+            return integer == 0 ? 0 : msb(integer) + 1;
+        }
+
+        // gets a constant at the given precision recomputing it only if the cached one is not precise enough
+        template<typename F>
+        static Integer cached(Cache& cache, size_t const bits, F&& compute) {
+            std::lock_guard lock(cache.mutex);
+            if (cache.bits < bits) {
+                cache.bits = bits + GUARD_BITS;
+                cache.value = compute(cache.bits);
+            }
+
+            return cache.value >> (cache.bits - bits);
+        }
+
+        // atan(1 / inverse)
+        static Integer arctangentOfInverse(unsigned const inverse, size_t const bits) {
+            Integer const squared = Integer(inverse) * inverse;
+            Integer power = one(bits) / inverse, sum = power;
+            for (unsigned k = 1; power != 0; ++k) {
+                power /= squared;
+                Integer const term = power / (2 * k + 1);
+                if (k % 2 == 0) sum += term;
+                else sum -= term;
+            }
+
+            return sum;
+        }
+
+        static Integer fixedPi(size_t const bits) {
+            static Cache cache;
+            return cached(cache, bits, [](size_t const cacheBits) {
+                // Machin's formula: pi = 16 atan(1/5) - 4 atan(1/239)
+                return 16 * arctangentOfInverse(5, cacheBits) - 4 * arctangentOfInverse(239, cacheBits);
+            });
+        }
+
+        static Integer fixedE(size_t const bits) {
+            static Cache cache;
+            return cached(cache, bits, [](size_t const cacheBits) {
+                Integer term = one(cacheBits), sum = term;
+                for (unsigned k = 1; term != 0; ++k) {
+                    term /= k;
+                    sum += term;
+                }
+
+                return sum;
+            });
+        }
+
+        // 2 atanh(value) = ln((1 + value) / (1 - value)) of a non-negative fixed-point value which is less than 1
+        static Integer fixedDoubleArtanh(Integer const& value, size_t const bits) {
+            Integer const squared = (value * value) >> bits;
+            Integer power = value, sum = value;
+            for (unsigned k = 1; power != 0; ++k) {
+                power = (power * squared) >> bits;
+                sum += power / (2 * k + 1);
+            }
+
+            return 2 * sum;
+        }
+
+        static Integer fixedLn2(size_t const bits) {
+            static Cache cache;
+            return cached(cache, bits, [](size_t const cacheBits) {
+                return fixedDoubleArtanh(one(cacheBits) / 3, cacheBits); // ln 2 = 2 atanh(1/3)
+            });
+        }
+
+        // sine and cosine of a reduced argument
+        static std::pair<Integer, Integer> fixedSinCos(Integer const& argument, size_t const bits) {
+            Integer const squared = (argument * argument) >> bits;
+            Integer sinTerm = argument, cosTerm = one(bits), sin = sinTerm, cos = cosTerm;
+            for (unsigned k = 1; sinTerm != 0 || cosTerm != 0; ++k) {
+                cosTerm = -((cosTerm * squared) >> bits) / ((2 * k - 1) * (2 * k));
+                sinTerm = -((sinTerm * squared) >> bits) / ((2 * k) * (2 * k + 1));
+                cos += cosTerm;
+                sin += sinTerm;
+            }
+
+            return {std::move(sin), std::move(cos)};
+        }
+
+        // sine and cosine of any value at the working precision `bits`
+        static std::pair<Integer, Integer> sinCos(T const& value, size_t const bits) {
+            auto const workingBits = bits + largeness(value) + GUARD_BITS;
+            auto const argument = toFixed(value, workingBits);
+            Integer const halfPi = fixedPi(workingBits) >> 1;
+
+            // argument = quadrant * pi/2 + reduced where |reduced| <= pi/4
+            Integer quadrant = (2 * argument + (argument < 0 ? -halfPi : halfPi)) / (2 * halfPi);
+            Integer const reduced = argument - quadrant * halfPi;
+            auto [sin, cos] = fixedSinCos(reduced, workingBits);
+            sin >>= workingBits - bits;
+            cos >>= workingBits - bits;
+            switch (static_cast<int>(quadrant % 4 + 4) % 4) {
+                case 1: return {std::move(cos), -sin};
+                case 2: return {-sin, -cos};
+                case 3: return {-cos, std::move(sin)};
+                default: return {std::move(sin), std::move(cos)};
+            }
+        }
+
+    public:
+        static T pi() {
+            auto const bits = Precision::bits();
+            return fromFixed(fixedPi(bits), bits);
+        }
+
+        static T e() {
+            auto const bits = Precision::bits();
+            return fromFixed(fixedE(bits), bits);
+        }
+
+        /**
+         * @brief Gets the square root of the value which is exact if the value is a square of a rational number.
+         *
+         * @throws OperationError if the value is negative
+         */
+        static T sqrt(T const& value) {
+            if (value < 0) throw OperationError("Square root of a negative number");
+
+            Integer const numeratorValue = numerator(value), denominatorValue = denominator(value);
+            Integer const numeratorRoot = boost::multiprecision::sqrt(numeratorValue),
+                          denominatorRoot = boost::multiprecision::sqrt(denominatorValue);
+            auto const exact = numeratorRoot * numeratorRoot == numeratorValue
+                               && denominatorRoot * denominatorRoot == denominatorValue;
+            if (exact) return T(numeratorRoot, denominatorRoot);
+
+            auto const bits = Precision::bits() + smallness(value) / 2;
+            return fromFixed(boost::multiprecision::sqrt(toFixed(value, 2 * bits)), bits);
+        }
+
+        /**
+         * @brief Gets the natural logarithm of the value.
+         *
+         * The value is reduced to `2^exponent * mantissa` where `mantissa` is within `[12/17, 17/12]`
+         * and `ln(mantissa) = 2 atanh((mantissa - 1) / (mantissa + 1))` whose series converges quickly.
+         *
+         * @throws OperationError if the value is not positive
+         */
+        static T ln(T const& value) {
+            if (value <= 0) throw OperationError("Logarithm of a non-positive number");
+            if (value == 1) return T{};
+
+            Integer const numeratorValue = numerator(value), denominatorValue = denominator(value);
+            auto exponent = int64_t(msb(numeratorValue)) - int64_t(msb(denominatorValue));
+            auto const scaled = [&](int64_t const power) {
+                return power >= 0 ? T(numeratorValue, denominatorValue << power)
+                                  : T(numeratorValue << -power, denominatorValue);
+            };
+            auto mantissa = scaled(exponent); // within (1/2, 2)
+            if (mantissa > T(17, 12)) mantissa = scaled(++exponent);
+            else if (mantissa < T(12, 17)) mantissa = scaled(--exponent);
+
+            // the logarithm of a value close to 1 is small and there is no other term for the absolute error
+            T const argument = (mantissa - 1) / (mantissa + 1);
+            auto const bits = Precision::bits() + (exponent == 0 ? smallness(argument) : 0);
+            auto const magnitude = static_cast<uint64_t>(exponent < 0 ? -exponent : exponent);
+            auto const workingBits = bits + GUARD_BITS + size_t(std::bit_width(magnitude));
+
+            Integer logarithm = fixedDoubleArtanh(toFixed(abs(argument), workingBits), workingBits);
+            if (argument < 0) logarithm = -logarithm;
+            logarithm += exponent * fixedLn2(workingBits);
+            Integer const rounded = abs(logarithm) >> (workingBits - bits);
+
+            return fromFixed(logarithm < 0 ? Integer(-rounded) : rounded, bits);
+        }
+
+        static T sin(T const& value) {
+            auto const bits = Precision::bits() + smallness(value);
+            return fromFixed(sinCos(value, bits).first, bits);
+        }
+
+        static T cos(T const& value) {
+            auto const bits = Precision::bits();
+            return fromFixed(sinCos(value, bits).second, bits);
+        }
+
+        /**
+         * @throws OperationError if the cosine is zero at the working precision
+         */
+        static T tg(T const& value) {
+            auto const bits = Precision::bits() + smallness(value);
+            auto const [sin, cos] = sinCos(value, bits);
+            if (cos == 0) throw OperationError("Tangent of an odd multiple of pi/2");
+
+            return ratio(sin, cos);
+        }
+
+        /**
+         * @throws OperationError if the sine is zero at the working precision
+         */
+        static T ctg(T const& value) {
+            auto const bits = Precision::bits() + smallness(value);
+            auto const [sin, cos] = sinCos(value, bits);
+            if (sin == 0) throw OperationError("Cotangent of a multiple of pi");
+
+            return ratio(cos, sin);
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_TRANSCENDENTAL_H_
@@ -1,25 +1,106 @@
 #ifndef INCLUDE_VARIABLES_H_
 #define INCLUDE_VARIABLES_H_
 
+#include <array>
+#include <cstdint>
 #include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
+/**
+ * @brief Values of variables stored in slots indexed by the variables' names.
+ *
+ * Variables are named by latin letters, `A`-`Z` occupy slots 0-25 and `a`-`z` occupy slots 26-51,
+ * so that a variable can be read by its slot (which is resolved once at parse time) with no lookup.
+ *
+ * @tparam V type of the variables' values
+ */
 template<typename V>
 class Variables final {
     typedef char K;
 
-    std::map<K, V> const values_;
+public:
+    static constexpr size_t SLOTS = 52;
+
+private:
+    std::array<V, SLOTS> values_{};
+    uint64_t bound_ = 0; // bit mask of the slots having values
 
 public:
+    static constexpr bool isName(K const name) noexcept {
+        return (name >= 'A' && name <= 'Z') || (name >= 'a' && name <= 'z');
+    }
+
+    /**
+     * @brief Gets the slot of the variable with the given name which should be a latin letter.
+     */
+    static constexpr size_t slotOf(K const name) noexcept {
+        return name <= 'Z' ? static_cast<size_t>(name - 'A') : static_cast<size_t>(name - 'a') + 26;
+    }
+
+    static constexpr K nameOf(size_t const slot) noexcept {
+        return static_cast<K>(slot < 26 ? 'A' + slot : 'a' + (slot - 26));
+    }
+
+    Variables() = default;
+
+    /**
+     * @brief Binds the values of the map skipping the names which are not latin letters
+     * as no expression can read them.
+     */
+    explicit Variables(std::map<K, V> const& values) {
+        for (auto const& [name, value] : values)
+            if (isName(name)) set(name, value);
+    }
+
+    explicit Variables(std::map<K, V>&& values) {
+        for (auto& [name, value] : values)
+            if (isName(name)) set(name, std::move(value));
+    }
+
+    /**
+     * @brief Sets the value of the variable with the given name.
+     *
+     * @throws std::invalid_argument if the name is not a latin letter
+     */
+    void set(K const name, V value) {
+        if (!isName(name)) throw std::invalid_argument("Invalid variable name: " + std::string(1, name));
+
+        auto const slot = slotOf(name);
+        values_[slot] = std::move(value);
+        bound_ |= uint64_t(1) << slot;
+    }
+
+    /**
+     * @brief Unbinds all the variables.
+     */
+    void clear() noexcept { bound_ = 0; }
+
+    /**
+     * @brief Gets the value stored in the given slot.
+     *
+     * @return pointer to the value or `nullptr` if the slot has no value
+     */
+    V const* find(size_t const slot) const noexcept {
+        return (bound_ >> slot & 1) != 0 ? &values_[slot] : nullptr;
+    }
 
-    explicit Variables(std::map<K, V> const& values) : values_(values) {}
+    /**
+     * @brief Gets the values of all the slots, only those of the slots in `bound()` are meaningful.
+     */
+    std::array<V, SLOTS> const& values() const noexcept { return values_; }
 
-    explicit Variables(std::map<K, V>&& values) : values_(values) {}
+    /**
+     * @brief Gets the bit mask of the slots having values.
+     */
+    uint64_t bound() const noexcept { return bound_; }
 
     std::optional<V> get(K const& name) const {
-        auto const& values = values_;
-        auto const iterator = values.find(name);
+        auto const value = isName(name) ? find(slotOf(name)) : nullptr;
 
-        return iterator == values.end() ? std::optional<V>() : std::optional<V>(iterator->second);
+        return value ? std::optional<V>(*value) : std::optional<V>();
     }
 };
 
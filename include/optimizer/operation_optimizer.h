@@ -0,0 +1,211 @@
+#ifndef INCLUDE_OPERATION_OPTIMIZER_H_
+#define INCLUDE_OPERATION_OPTIMIZER_H_
+
+#include <operation/operation_transformer.h>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Simplifies an AST so that only its variable-dependent part is left to be evaluated.
+     *
+     * Subtrees without variables are folded into constants (unless their evaluation fails),
+     * trivial identities (`x * 1`, `x + 0`, `--x`, `x ^ 1` etc.) are removed, nested sums
+     * are merged into a single one and constant factors of nested products are gathered together.
+     * Sums and products may be reassociated so floating-point results may differ in the last bits.
+     *
+     * @tparam T result of the optimized operations
+     */
+    template<typename T>
+    class OperationOptimizer final : public OperationTransformer<T> {
+        typedef typename OperationTransformer<T>::OperationPointer OperationPointer;
+
+        Variables<T> const noVariables_;
+
+        static ConstOperation<T> const* asConstant(OperationPointer const& operation) noexcept {
+            return dynamic_cast<ConstOperation<T> const*>(operation.get());
+        }
+
+        static bool isConstant(OperationPointer const& operation, T const& value) {
+            auto const constant = asConstant(operation);
+            return constant && constant->value() == value;
+        }
+
+        static OperationPointer constant(T&& value) { return std::make_shared<ConstOperation<T>>(std::move(value)); }
+
+        // replaces an operation of constants with its result keeping it as is if it can't be evaluated
+        OperationPointer fold(OperationPointer const& operation) const {
+            try {
+                return constant(operation->result(noVariables_));
+            } catch (OperationError const&) { return operation; }
+        }
+
+        template<typename O>
+        void simplifyUnary(O const& operation) {
+            auto operand = this->transform(operation.operand());
+            auto const constantOperand = asConstant(operand) != nullptr;
+            auto simplified = operand == operation.operand() ? this->current()
+                                                             : std::make_shared<O>(std::move(operand));
+
+            this->replace(constantOperand ? fold(simplified) : std::move(simplified));
+        }
+
+        // negates an already simplified operation
+        OperationPointer negate(OperationPointer operand) const {
+            if (asConstant(operand)) return fold(std::make_shared<NegativeOperation<T>>(std::move(operand)));
+
+            // double negation
+            if (auto const negative = dynamic_cast<NegativeOperation<T> const*>(operand.get()))
+                return negative->operand();
+            if (auto const inverted = dynamic_cast<InvertOperation<T> const*>(operand.get()))
+                return inverted->operand();
+
+            return std::make_shared<NegativeOperation<T>>(std::move(operand));
+        }
+
+        // adds an already simplified term to the sum
+        static void addTerm(OperationPointer const& term, std::vector<OperationPointer>& terms, T& constantSum,
+                            bool& hasConstant) {
+            if (auto const plus = dynamic_cast<PlusOperation<T> const*>(term.get())) {
+                addTerm(plus->leftOperand(), terms, constantSum, hasConstant);
+                addTerm(plus->rightOperand(), terms, constantSum, hasConstant);
+            } else if (auto const sum = dynamic_cast<VectorSumOperation<T> const*>(term.get())) {
+                for (auto const& element : sum->operands()) addTerm(element, terms, constantSum, hasConstant);
+            } else if (auto const constant = asConstant(term)) {
+                constantSum += constant->value();
+                hasConstant = true;
+            } else
+                terms.push_back(term);
+        }
+
+        template<typename O>
+        void simplifySum(O const& operation) {
+            std::vector<OperationPointer> terms;
+            T constantSum{};
+            auto hasConstant = false;
+            if constexpr (std::is_same_v<O, PlusOperation<T>>) {
+                addTerm(this->transform(operation.leftOperand()), terms, constantSum, hasConstant);
+                addTerm(this->transform(operation.rightOperand()), terms, constantSum, hasConstant);
+            } else
+                for (auto const& element : operation.operands())
+                    addTerm(this->transform(element), terms, constantSum, hasConstant);
+
+            if (hasConstant && (terms.empty() || !(constantSum == T{})))
+                terms.push_back(constant(std::move(constantSum)));
+
+            switch (terms.size()) {
+                case 0: return this->replace(constant(T{}));
+                case 1: return this->replace(terms[0]);
+                case 2: return this->replace(std::make_shared<PlusOperation<T>>(terms[0], terms[1]));
+                default: return this->replace(std::make_shared<VectorSumOperation<T>>(std::move(terms)));
+            }
+        }
+
+        // adds an already simplified factor to the product
+        static void addFactor(OperationPointer const& factor, std::vector<OperationPointer>& factors,
+                              T& constantProduct, bool& hasConstant) {
+            if (auto const multiply = dynamic_cast<MultiplyOperation<T> const*>(factor.get())) {
+                addFactor(multiply->leftOperand(), factors, constantProduct, hasConstant);
+                addFactor(multiply->rightOperand(), factors, constantProduct, hasConstant);
+            } else if (auto const constant = asConstant(factor)) {
+                constantProduct *= constant->value();
+                hasConstant = true;
+            } else
+                factors.push_back(factor);
+        }
+
+    public:
+        /**
+         * @brief Optimizes the given operation.
+         *
+         * @param operation operation to optimize
+         * @return operation having the same result which may be the given one
+         */
+        static OperationPointer optimize(OperationPointer const& operation) {
+            return OperationOptimizer().transform(operation);
+        }
+
+        void visit(ConstEOperation<T> const& operation) override {
+            this->replace(constant(ConstEOperation<T>::compute()));
+        }
+
+        void visit(ConstPiOperation<T> const& operation) override {
+            this->replace(constant(ConstPiOperation<T>::compute()));
+        }
+
+        void visit(PlusOperation<T> const& operation) override { simplifySum(operation); }
+
+        void visit(VectorSumOperation<T> const& operation) override { simplifySum(operation); }
+
+        void visit(NegativeOperation<T> const& operation) override {
+            this->replace(negate(this->transform(operation.operand())));
+        }
+
+        void visit(InvertOperation<T> const& operation) override {
+            this->replace(negate(this->transform(operation.operand())));
+        }
+
+        void visit(MinusOperation<T> const& operation) override {
+            auto left = this->transform(operation.leftOperand()), right = this->transform(operation.rightOperand());
+            if (asConstant(left) && asConstant(right))
+                return this->replace(fold(std::make_shared<MinusOperation<T>>(left, right)));
+            if (isConstant(right, T{})) return this->replace(left);
+            if (isConstant(left, T{})) return this->replace(negate(std::move(right))); // 0 - x = -x
+
+            this->replace(std::make_shared<MinusOperation<T>>(std::move(left), std::move(right)));
+        }
+
+        void visit(MultiplyOperation<T> const& operation) override {
+            std::vector<OperationPointer> factors;
+            T constantProduct(1);
+            auto hasConstant = false;
+            addFactor(this->transform(operation.leftOperand()), factors, constantProduct, hasConstant);
+            addFactor(this->transform(operation.rightOperand()), factors, constantProduct, hasConstant);
+
+            if (factors.empty()) return this->replace(constant(std::move(constantProduct)));
+
+            auto product = factors[0];
+            for (size_t i = 1; i < factors.size(); ++i)
+                product = std::make_shared<MultiplyOperation<T>>(std::move(product), factors[i]);
+
+            if (!hasConstant || constantProduct == T(1)) return this->replace(product);
+            if (constantProduct == T(-1)) return this->replace(negate(std::move(product)));
+            this->replace(std::make_shared<MultiplyOperation<T>>(constant(std::move(constantProduct)), product));
+        }
+
+        void visit(DivideOperation<T> const& operation) override {
+            auto left = this->transform(operation.leftOperand()), right = this->transform(operation.rightOperand());
+            if (asConstant(left) && asConstant(right))
+                return this->replace(fold(std::make_shared<DivideOperation<T>>(left, right)));
+            if (isConstant(right, T(1))) return this->replace(left);
+
+            this->replace(std::make_shared<DivideOperation<T>>(std::move(left), std::move(right)));
+        }
+
+        void visit(PowOperation<T> const& operation) override {
+            auto left = this->transform(operation.leftOperand()), right = this->transform(operation.rightOperand());
+            if (asConstant(left) && asConstant(right))
+                return this->replace(fold(std::make_shared<PowOperation<T>>(left, right)));
+            if (isConstant(right, T(1))) return this->replace(left);
+
+            this->replace(std::make_shared<PowOperation<T>>(std::move(left), std::move(right)));
+        }
+
+        void visit(PrimitiveSqrtOperation<T> const& operation) override { simplifyUnary(operation); }
+
+        void visit(SinOperation<T> const& operation) override { simplifyUnary(operation); }
+
+        void visit(CosOperation<T> const& operation) override { simplifyUnary(operation); }
+
+        void visit(TgOperation<T> const& operation) override { simplifyUnary(operation); }
+
+        void visit(CtgOperation<T> const& operation) override { simplifyUnary(operation); }
+    };
+
+    template<typename T>
+    std::shared_ptr<Operation<T>> optimize(std::shared_ptr<Operation<T>> const& operation) {
+        return OperationOptimizer<T>::optimize(operation);
+    }
+} // namespace calculator
+
+#endif //INCLUDE_OPERATION_OPTIMIZER_H_
@@ -0,0 +1,153 @@
+#ifndef INCLUDE_CACHING_EXPRESSION_PARSER_H_
+#define INCLUDE_CACHING_EXPRESSION_PARSER_H_
+
+#include <algorithm>
+#include <cctype>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <parser/expression_parser.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace calculator {
+
+    struct CacheStatistics {
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+    };
+
+    /**
+     * @brief Parser keeping the operations of the recently parsed expressions so that repeated ones are not parsed.
+     *
+     * Expressions are looked up by their normalized text in which whitespace is only kept between letters
+     * or digits where it separates tokens. The least recently used operation is evicted when the cache is full.
+     * Parsed operations are immutable so a cached one is shared by all the callers.
+     * The parser may be used by several threads at once, the wrapped one is only called by one of them at a time.
+     *
+     * @tparam T result of the parsed operations
+     */
+    template<typename T>
+    class CachingExpressionParser final : public ExpressionParser<T> {
+        typedef std::shared_ptr<Operation<T>> OperationPointer;
+
+        struct Entry {
+            std::string expression;
+            OperationPointer operation;
+        };
+
+        std::shared_ptr<ExpressionParser<T>> const parser_;
+        size_t const capacity_;
+        std::mutex mutex_, parserMutex_;
+        std::list<Entry> entries_; // from the most recently used one
+        std::unordered_map<std::string_view, typename std::list<Entry>::iterator> index_; // views of the entries
+        CacheStatistics statistics_{0, 0, 0};
+
+        static bool isWordCharacter(char const character) noexcept {
+            return std::isalnum(static_cast<unsigned char>(character)) || character == ',';
+        }
+
+        static std::string normalize(std::string_view const& expression) {
+            std::string normalized;
+            normalized.reserve(expression.size());
+            auto separated = false;
+            for (auto const character : expression) {
+                if (std::isspace(static_cast<unsigned char>(character))) {
+                    separated = true;
+                    continue;
+                }
+                if (separated && !normalized.empty() && isWordCharacter(normalized.back())
+                    && isWordCharacter(character))
+                    normalized += ' ';
+                normalized += character;
+                separated = false;
+            }
+
+            return normalized;
+        }
+
+        OperationPointer find(std::string const& expression) {
+            std::lock_guard lock(mutex_);
+            auto const found = index_.find(expression);
+            if (found == index_.end()) {
+                ++statistics_.misses;
+                return nullptr;
+            }
+
+            ++statistics_.hits;
+            entries_.splice(entries_.begin(), entries_, found->second);
+            return found->second->operation;
+        }
+
+        OperationPointer insert(std::string&& expression, OperationPointer&& operation) {
+            std::lock_guard lock(mutex_);
+            auto const found = index_.find(expression);
+            if (found != index_.end()) return found->second->operation; // parsed by another thread meanwhile
+
+            entries_.push_front({std::move(expression), std::move(operation)});
+            index_.emplace(entries_.front().expression, entries_.begin());
+            if (entries_.size() > capacity_) {
+                index_.erase(entries_.back().expression);
+                entries_.pop_back();
+                ++statistics_.evictions;
+            }
+
+            return entries_.front().operation;
+        }
+
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+        /**
+         * @param parser parser of the expressions which are not cached
+         * @param capacity maximal number of cached operations
+         */
+        explicit CachingExpressionParser(std::shared_ptr<ExpressionParser<T>> parser,
+                                         size_t const capacity = DEFAULT_CAPACITY)
+            : parser_(std::move(parser)), capacity_(std::max<size_t>(capacity, 1)) {}
+
+        OperationPointer parse(std::istream& input) override {
+            std::string line;
+            getline(input, line);
+
+            return parse(line);
+        }
+
+        OperationPointer parse(std::string_view const& expression) override {
+            auto normalized = normalize(expression);
+            if (auto cached = find(normalized)) return cached;
+
+            OperationPointer parsed;
+            {
+                std::lock_guard lock(parserMutex_);
+                parsed = parser_->parse(std::string_view(normalized));
+            }
+
+            return insert(std::move(normalized), std::move(parsed));
+        }
+
+        /**
+         * @brief Gets the numbers of cache hits, misses and evictions since the creation of this parser.
+         */
+        CacheStatistics statistics() {
+            std::lock_guard lock(mutex_);
+            return statistics_;
+        }
+
+        size_t size() {
+            std::lock_guard lock(mutex_);
+            return entries_.size();
+        }
+
+        void clear() {
+            std::lock_guard lock(mutex_);
+            index_.clear();
+            entries_.clear();
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_CACHING_EXPRESSION_PARSER_H_
@@ -4,7 +4,10 @@
 #include <istream>
 #include <memory>
 #include <operation/operation.h>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 
 namespace calculator {
 
@@ -23,6 +26,16 @@ namespace calculator {
     class ExpressionParser {
     public:
         virtual std::shared_ptr<Operation<T>> parse(std::istream& input) = 0;
+
+        /**
+         * @brief Parses the given expression.
+         *
+         * Unless overridden the expression is copied into a stream which is then parsed.
+         */
+        virtual std::shared_ptr<Operation<T>> parse(std::string_view const& expression) {
+            std::istringstream input{std::string(expression)};
+            return parse(input);
+        }
     };
 } // namespace calculator
 
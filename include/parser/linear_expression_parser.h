@@ -0,0 +1,409 @@
+#ifndef INCLUDE_LINEAR_EXPRESSION_PARSER_H_
+#define INCLUDE_LINEAR_EXPRESSION_PARSER_H_
+
+#include <algorithm>
+#include <bytecode/compiled_operation.h>
+#include <cctype>
+#include <memory>
+#include <operation/algebraic_operations.h>
+#include <operation/const_operation.h>
+#include <parser/expression_parser.h>
+#include <parser/number_literal.h>
+#include <parser/operation_factory.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Parser reading an expression in a single pass using the shunting-yard algorithm with explicit stacks.
+     *
+     * Parsing takes linear time and constant call stack whatever the input is,
+     * and the depth of the built AST is limited so that its recursive evaluation can't overflow the call stack
+     * (chains of additions and subtractions are parsed into a single sum so that they don't add depth).
+     * As with the simple parser structurally identical sub-expressions are shared
+     * and the DAG having any is compiled so that each of them is evaluated once.
+     *
+     * Binary operators are left-associative except for the right-associative `^`, unary minus binds tighter
+     * than multiplication but weaker than `^` and functions are applied to the nearest operand (`sin x ^ 2` is
+     * `(sin x) ^ 2`).
+     *
+     * @tparam T result of the parsed operations
+     */
+    template<typename T>
+    class LinearExpressionParser final : public ExpressionParser<T> {
+        typedef std::shared_ptr<Operation<T>> OperationPointer;
+
+        enum class Symbol : uint8_t {
+            LEFT_PARENTHESIS,
+            PLUS,
+            MINUS,
+            MULTIPLY,
+            DIVIDE,
+            NEGATIVE,
+            POW,
+            SQRT,
+            EXP,
+            SIN,
+            COS,
+            TG,
+            CTG
+        };
+
+        static int priority(Symbol const symbol) noexcept {
+            switch (symbol) {
+                case Symbol::LEFT_PARENTHESIS: return 0;
+                case Symbol::PLUS:
+                case Symbol::MINUS: return 1;
+                case Symbol::MULTIPLY:
+                case Symbol::DIVIDE: return 2;
+                case Symbol::NEGATIVE: return 3;
+                case Symbol::POW: return 4;
+                default: return 5; // functions
+            }
+        }
+
+        struct Function {
+            std::string_view name;
+            Symbol symbol;
+        };
+
+        // names sharing a prefix are ordered from the longest one
+        static constexpr Function FUNCTIONS[] = {{"sqrt", Symbol::SQRT}, {"sin", Symbol::SIN}, {"cos", Symbol::COS},
+                                                 {"ctg", Symbol::CTG},   {"tg", Symbol::TG},   {"exp", Symbol::EXP}};
+
+        struct Term {
+            OperationPointer operation;
+            bool negative;
+        };
+
+        struct Operand {
+            OperationPointer operation;
+            size_t depth;
+            std::vector<Term> terms; // terms of a sum whose operation is not created yet
+        };
+
+        // state of parsing which is kept between parsings to reuse the allocated memory
+        class Context final {
+            OperationFactory<T> factory_;
+            size_t const maxDepth_;
+            std::vector<Operand> operands_;
+            std::vector<Symbol> operators_;
+
+            Operand popOperand() {
+                auto operand = std::move(operands_.back());
+                operands_.pop_back();
+
+                return operand;
+            }
+
+            OperationPointer operation(Operand&& operand) {
+                auto& terms = operand.terms;
+                switch (terms.size()) {
+                    case 0: return std::move(operand.operation);
+                    case 2: {
+                        if (terms[1].negative)
+                            return factory_.template create<MinusOperation<T>>(terms[0].operation, terms[1].operation);
+                        return factory_.template create<PlusOperation<T>>(terms[0].operation, terms[1].operation);
+                    }
+                    default: {
+                        std::vector<OperationPointer> operations;
+                        operations.reserve(terms.size());
+                        for (auto& term : terms) {
+                            if (term.negative)
+                                term.operation = factory_.template create<NegativeOperation<T>>(term.operation);
+                            operations.push_back(std::move(term.operation));
+                        }
+
+                        return factory_.template create<VectorSumOperation<T>>(std::move(operations));
+                    }
+                }
+            }
+
+            void checkDepth(size_t const depth) const {
+                if (depth > maxDepth_) throw InvalidExpression("The expression is nested too deeply");
+            }
+
+            template<typename O, typename... A>
+            void pushOperation(size_t const depth, A&&... operands) {
+                checkDepth(depth);
+                operands_.push_back({factory_.template create<O>(std::forward<A>(operands)...), depth, {}});
+            }
+
+            template<typename O>
+            void reduceUnary() {
+                auto operand = popOperand();
+                auto const depth = operand.depth + 1;
+                pushOperation<O>(depth, operation(std::move(operand)));
+            }
+
+            template<typename O>
+            void reduceBinary() {
+                auto right = popOperand(), left = popOperand();
+                auto const depth = std::max(left.depth, right.depth) + 1;
+                pushOperation<O>(depth, operation(std::move(left)), operation(std::move(right)));
+            }
+
+            // small constant powers of leaves are multiplications which are cheaper than any pow
+            void reducePow() {
+                auto right = popOperand(), left = popOperand();
+                auto const depth = std::max(left.depth, right.depth) + 1;
+                auto base = operation(std::move(left)), exponent = operation(std::move(right));
+
+                auto const constant = dynamic_cast<ConstOperation<T> const*>(exponent.get());
+                auto const leaf = dynamic_cast<VariableOperation<T> const*>(base.get())
+                                  || dynamic_cast<ConstOperation<T> const*>(base.get());
+                if (constant && leaf && (constant->value() == T(2) || constant->value() == T(3))) {
+                    auto const cube = constant->value() == T(3);
+                    checkDepth(depth + cube);
+                    auto power = factory_.template create<MultiplyOperation<T>>(base, base);
+                    if (cube) power = factory_.template create<MultiplyOperation<T>>(std::move(power), base);
+                    operands_.push_back({std::move(power), depth + cube, {}});
+                    return;
+                }
+
+                pushOperation<PowOperation<T>>(depth, std::move(base), std::move(exponent));
+            }
+
+            // terms of a sum are collected into a single operation so that long sums don't make the AST deep
+            void reduceSum(bool const negative) {
+                auto right = popOperand(), sum = popOperand();
+                if (sum.terms.empty()) {
+                    Operand started{nullptr, sum.depth + 1, {}};
+                    started.terms.push_back({std::move(sum.operation), false});
+                    sum = std::move(started);
+                }
+                sum.depth = std::max(sum.depth, right.depth + (negative ? 2 : 1));
+                checkDepth(sum.depth);
+
+                sum.terms.push_back({operation(std::move(right)), negative});
+                operands_.push_back(std::move(sum));
+            }
+
+            void reduce(Symbol const symbol) {
+                switch (symbol) {
+                    case Symbol::LEFT_PARENTHESIS: throw InvalidExpression("Imbalanced parentheses in expression");
+                    case Symbol::PLUS: return reduceSum(false);
+                    case Symbol::MINUS: return reduceSum(true);
+                    case Symbol::MULTIPLY: return reduceBinary<MultiplyOperation<T>>();
+                    case Symbol::DIVIDE: return reduceBinary<DivideOperation<T>>();
+                    case Symbol::NEGATIVE: return reduceUnary<NegativeOperation<T>>();
+                    case Symbol::POW: return reducePow();
+                    case Symbol::SQRT: return reduceUnary<PrimitiveSqrtOperation<T>>();
+                    case Symbol::EXP: {
+                        auto operand = popOperand();
+                        auto const depth = operand.depth + 1;
+                        return pushOperation<PowOperation<T>>(depth, factory_.template create<ConstEOperation<T>>(),
+                                                              operation(std::move(operand)));
+                    }
+                    case Symbol::SIN: return reduceUnary<SinOperation<T>>();
+                    case Symbol::COS: return reduceUnary<CosOperation<T>>();
+                    case Symbol::TG: return reduceUnary<TgOperation<T>>();
+                    case Symbol::CTG: return reduceUnary<CtgOperation<T>>();
+                }
+            }
+
+        public:
+            explicit Context(size_t const maxDepth) noexcept : maxDepth_(maxDepth) {}
+
+            InterningStatistics const& statistics() const noexcept { return factory_.statistics(); }
+
+            void reset() noexcept {
+                factory_.reset();
+                operands_.clear();
+                operators_.clear();
+            }
+
+            template<typename O, typename... A>
+            void pushValue(A&&... arguments) {
+                operands_.push_back({factory_.template create<O>(std::forward<A>(arguments)...), 1, {}});
+            }
+
+            void pushPrefix(Symbol const symbol) { operators_.push_back(symbol); }
+
+            void pushBinary(Symbol const symbol) {
+                auto const pushedPriority = priority(symbol);
+                auto const rightAssociative = symbol == Symbol::POW;
+                while (!operators_.empty()) {
+                    auto const topPriority = priority(operators_.back());
+                    if (topPriority < pushedPriority || (topPriority == pushedPriority && rightAssociative)) break;
+
+                    reduce(operators_.back());
+                    operators_.pop_back();
+                }
+                operators_.push_back(symbol);
+            }
+
+            void closeParenthesis(size_t const index) {
+                while (!operators_.empty() && operators_.back() != Symbol::LEFT_PARENTHESIS) {
+                    reduce(operators_.back());
+                    operators_.pop_back();
+                }
+                if (operators_.empty())
+                    throw InvalidExpression("Imbalanced parentheses: a closing one was found at index "
+                                            + std::to_string(index));
+                operators_.pop_back();
+            }
+
+            OperationPointer finish() {
+                while (!operators_.empty()) {
+                    reduce(operators_.back());
+                    operators_.pop_back();
+                }
+
+                return operation(popOperand());
+            }
+        };
+
+        Context context_;
+        InterningStatistics statistics_{0, 0, 0};
+
+        static bool matches(std::string_view const& expression, size_t const index, std::string_view const& name) {
+            if (expression.size() - index < name.size()) return false;
+            for (size_t i = 0; i < name.size(); ++i)
+                if (std::tolower(static_cast<unsigned char>(expression[index + i])) != name[i]) return false;
+
+            return true;
+        }
+
+        static bool isDigit(char const character) noexcept { return character >= '0' && character <= '9'; }
+
+        // reads the operand or prefix operator at the given index returning whether an operand is still expected
+        static bool readOperand(std::string_view const& expression, size_t& index, Context& context) {
+            auto const character = expression[index];
+            if (isDigit(character) || character == ',') {
+                auto const begin = index;
+                while (index < expression.size() && isDigit(expression[index])) ++index;
+                if (index < expression.size() && expression[index] == ',') {
+                    auto const fraction = ++index;
+                    while (index < expression.size() && isDigit(expression[index])) ++index;
+                    if (index == fraction)
+                        throw InvalidExpression("Meaningless comma at index " + std::to_string(fraction - 1));
+                }
+                context.template pushValue<ConstOperation<T>>(
+                        parseNumberLiteral<T>(expression.substr(begin, index - begin)));
+
+                return false;
+            }
+
+            switch (character) {
+                case '(': {
+                    ++index;
+                    context.pushPrefix(Symbol::LEFT_PARENTHESIS);
+                    return true;
+                }
+                case '-': {
+                    ++index;
+                    context.pushPrefix(Symbol::NEGATIVE);
+                    return true;
+                }
+                case '+': { // unary plus changes nothing
+                    ++index;
+                    return true;
+                }
+            }
+
+            if (!std::isalpha(static_cast<unsigned char>(character)))
+                throw InvalidExpression("Unexpected symbol `" + std::string(1, character) + "` at index "
+                                        + std::to_string(index) + " where an operand is expected");
+
+            for (auto const& function : FUNCTIONS)
+                if (matches(expression, index, function.name)) {
+                    index += function.name.size();
+                    context.pushPrefix(function.symbol);
+                    return true;
+                }
+            if (matches(expression, index, "pi")) {
+                index += 2;
+                context.template pushValue<ConstPiOperation<T>>();
+            } else if (character == 'e' || character == 'E') {
+                ++index;
+                context.template pushValue<ConstEOperation<T>>();
+            } else {
+                ++index;
+                context.template pushValue<VariableOperation<T>>(character);
+            }
+
+            return false;
+        }
+
+        // reads the binary operator or closing parenthesis at the given index returning whether an operand is expected
+        static bool readOperator(std::string_view const& expression, size_t& index, Context& context) {
+            auto const character = expression[index];
+            Symbol symbol;
+            switch (character) {
+                case ')': {
+                    context.closeParenthesis(index++);
+                    return false;
+                }
+                case '+': symbol = Symbol::PLUS; break;
+                case '-': symbol = Symbol::MINUS; break;
+                case '*': symbol = Symbol::MULTIPLY; break;
+                case '/': symbol = Symbol::DIVIDE; break;
+                case '^': symbol = Symbol::POW; break;
+                default:
+                    throw InvalidExpression("Unexpected symbol `" + std::string(1, character) + "` at index "
+                                            + std::to_string(index) + " where an operator is expected");
+            }
+            ++index;
+            context.pushBinary(symbol);
+
+            return true;
+        }
+
+    public:
+        static constexpr size_t DEFAULT_MAX_DEPTH = 10000;
+
+        /**
+         * @param maxDepth maximal depth of the parsed AST
+         */
+        explicit LinearExpressionParser(size_t const maxDepth = DEFAULT_MAX_DEPTH) noexcept : context_(maxDepth) {}
+
+        /**
+         * @brief Parses the given expression.
+         *
+         * @param expression expression which may contain whitespace, it is read in place
+         * @return operation of the expression
+         * @throws InvalidExpression if the expression is invalid or nested deeper than allowed
+         */
+        OperationPointer parse(std::string_view const& expression) override {
+            auto& context = context_;
+            context.reset(); // in case the previous parsing has failed
+
+            auto operandExpected = true;
+            for (size_t index = 0; index < expression.size();) {
+                if (std::isspace(static_cast<unsigned char>(expression[index]))) {
+                    ++index;
+                    continue;
+                }
+
+                operandExpected = operandExpected ? readOperand(expression, index, context)
+                                                  : readOperator(expression, index, context);
+            }
+            if (operandExpected) throw InvalidExpression("Unexpected end of expression where an operand is expected");
+
+            auto operation = context.finish();
+            statistics_ = context.statistics();
+            context.reset();
+
+            return statistics_.shared == 0 ? operation
+                                                 : std::make_shared<CompiledOperation<T>>(std::move(operation));
+        }
+
+        OperationPointer parse(std::istream& input) override {
+            std::string line;
+            getline(input, line);
+
+            return parse(line);
+        }
+
+        /**
+         * @brief Gets the numbers of created, deduplicated and shared operations of the last parsed expression.
+         */
+        InterningStatistics const& statistics() const noexcept { return statistics_; }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_LINEAR_EXPRESSION_PARSER_H_
@@ -0,0 +1,103 @@
+#ifndef INCLUDE_NUMBER_LITERAL_H_
+#define INCLUDE_NUMBER_LITERAL_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <parser/expression_parser.h>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace calculator {
+
+    /**
+     * @brief Checks if the text is a number literal of an expression.
+     *
+     * @return `true` if it consists of an optional minus and digits optionally separated by a single decimal comma
+     */
+    inline bool isNumberLiteral(std::string_view text) noexcept {
+        if (!text.empty() && text.front() == '-') text.remove_prefix(1);
+
+        auto digits = false, comma = false;
+        for (auto const character : text) {
+            if (character >= '0' && character <= '9') digits = true;
+            else if (character == ',' && !comma) comma = true;
+            else return false;
+        }
+
+        return digits;
+    }
+
+    /**
+     * @brief Converts a number literal of an expression into a value reading its characters in place.
+     *
+     * @param literal optional minus and digits optionally separated by a decimal comma
+     * @return value of the literal
+     * @throws InvalidExpression if the literal is not a number
+     */
+    template<typename T>
+    T parseNumberLiteral(std::string_view literal) {
+        if (!isNumberLiteral(literal)) throw InvalidExpression("Invalid number `" + std::string(literal) + '`');
+        if (literal.front() == '-') return -parseNumberLiteral<T>(literal.substr(1));
+
+        if constexpr (std::is_floating_point_v<T>) {
+            // the decimal separator of expressions is a comma so a copy with a dot is made (on the stack if it fits)
+            char buffer[64];
+            std::string longLiteral;
+            auto text = buffer;
+            if (literal.size() > sizeof(buffer)) {
+                longLiteral.resize(literal.size());
+                text = longLiteral.data();
+            }
+            std::replace_copy(literal.begin(), literal.end(), text, ',', '.');
+
+            T value{};
+            auto const [end, error] = std::from_chars(text, text + literal.size(), value);
+            if (end != text + literal.size()) throw InvalidExpression("Invalid number `" + std::string(literal) + '`');
+            if (error == std::errc::result_out_of_range) {
+                // rounded as by `strtod`: to infinity if the literal has a non-zero integer part, to zero otherwise
+                auto const integer = literal.substr(0, literal.find(','));
+                auto const large = std::any_of(integer.begin(), integer.end(), [](char const c) { return c != '0'; });
+                return large ? std::numeric_limits<T>::infinity() : T{};
+            }
+
+            return value;
+        } else {
+            // digits are accumulated by chunks fitting into 64 bits, the value is then divided by 10^(fraction digits)
+            static constexpr uint64_t CHUNK_SCALE = 1'000'000'000'000'000'000u;
+
+            T value{};
+            uint64_t chunk = 0, chunkScale = 1;
+            size_t fractionDigits = 0;
+            auto fraction = false;
+            for (auto const character : literal) {
+                if (character == ',') {
+                    fraction = true;
+                    continue;
+                }
+                chunk = chunk * 10 + static_cast<unsigned>(character - '0');
+                chunkScale *= 10;
+                fractionDigits += fraction;
+                if (chunkScale == CHUNK_SCALE) {
+                    value = value * T(chunkScale) + T(chunk);
+                    chunk = 0;
+                    chunkScale = 1;
+                }
+            }
+            if (chunkScale != 1) value = value * T(chunkScale) + T(chunk);
+            if (fractionDigits == 0) return value;
+
+            T scale(1);
+            for (; fractionDigits >= 18; fractionDigits -= 18) scale *= T(CHUNK_SCALE);
+            uint64_t lastScale = 1;
+            while (fractionDigits-- != 0) lastScale *= 10;
+
+            return T(value / (scale * T(lastScale)));
+        }
+    }
+} // namespace calculator
+
+#endif //INCLUDE_NUMBER_LITERAL_H_
@@ -0,0 +1,129 @@
+#ifndef INCLUDE_OPERATION_FACTORY_H_
+#define INCLUDE_OPERATION_FACTORY_H_
+
+#include <boost/container_hash/hash.hpp>
+#include <map>
+#include <memory>
+#include <operation/algebraic_operations.h>
+#include <operation/const_operation.h>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Numbers of operations requested from a factory.
+     */
+    struct InterningStatistics {
+        size_t created;      // operations which have been actually created
+        size_t deduplicated; // requests answered with an already created operation
+        size_t shared;       // deduplicated operations having operands, i.e. common sub-expressions
+    };
+
+    /**
+     * @brief Factory of operations interning structurally identical ones
+     * so that common sub-expressions become shared nodes of a DAG.
+     *
+     * Operations are identified by their type, their operands (by identity, which is enough
+     * since the operands themselves are interned) and the name of the variable or the constant value.
+     *
+     * @tparam T result of the created operations
+     */
+    template<typename T>
+    class OperationFactory final {
+        typedef std::shared_ptr<Operation<T>> OperationPointer;
+
+        struct Key {
+            std::type_index type;
+            char name;
+            Operation<T> const *left, *right;         // operands of unary and binary operations
+            std::vector<Operation<T> const*> operands; // operands of sums
+
+            bool operator==(Key const& other) const = default;
+        };
+
+        struct KeyHash {
+            size_t operator()(Key const& key) const noexcept {
+                auto hash = key.type.hash_code();
+                boost::hash_combine(hash, key.name);
+                boost::hash_combine(hash, key.left);
+                boost::hash_combine(hash, key.right);
+                for (auto const operand : key.operands) boost::hash_combine(hash, operand);
+
+                return hash;
+            }
+        };
+
+        std::unordered_map<Key, OperationPointer, KeyHash> operations_;
+        std::map<T, OperationPointer> constants_;
+        InterningStatistics statistics_{0, 0, 0};
+
+        static void addToKey(Key& key, OperationPointer const& operand) noexcept {
+            (key.left ? key.right : key.left) = operand.get();
+        }
+
+        static void addToKey(Key& key, std::vector<OperationPointer> const& operands) {
+            for (auto const& operand : operands) key.operands.push_back(operand.get());
+        }
+
+        static void addToKey(Key& key, char const name) noexcept { key.name = name; }
+
+    public:
+        /**
+         * @brief Forgets all the created operations.
+         *
+         * The tables of the factory are kept allocated so that it is cheap to reuse it for another expression.
+         */
+        void reset() noexcept {
+            operations_.clear();
+            constants_.clear();
+            statistics_ = {0, 0, 0};
+        }
+
+        /**
+         * @brief Gets an operation equal to `O(arguments...)` creating it only if there is no such one yet.
+         *
+         * @tparam O type of the operation
+         * @param arguments arguments of the operation's constructor
+         * @return interned operation
+         */
+        template<typename O, typename... A>
+        OperationPointer create(A&&... arguments) {
+            if constexpr (std::is_same_v<O, ConstOperation<T>>) {
+                auto const [constant, inserted] = constants_.try_emplace(T(arguments...));
+                if (inserted) constant->second = std::make_shared<O>(std::forward<A>(arguments)...);
+
+                return intern<O>(inserted, constant->second);
+            } else {
+                Key key{typeid(O), '\0', nullptr, nullptr, {}};
+                (addToKey(key, arguments), ...);
+
+                auto const [operation, inserted] = operations_.try_emplace(std::move(key));
+                if (inserted) operation->second = std::make_shared<O>(std::forward<A>(arguments)...);
+
+                return intern<O>(inserted, operation->second);
+            }
+        }
+
+        /**
+         * @brief Gets the numbers of operations created, deduplicated and shared by this factory.
+         */
+        InterningStatistics const& statistics() const noexcept { return statistics_; }
+
+    private:
+        template<typename O>
+        OperationPointer const& intern(bool const created, OperationPointer const& operation) noexcept {
+            ++(created ? statistics_.created : statistics_.deduplicated);
+            if (!created && (std::is_base_of_v<UnaryOperation<T>, O> || std::is_base_of_v<BinaryOperation<T>, O>
+                             || std::is_same_v<O, VectorSumOperation<T>>))
+                ++statistics_.shared;
+
+            return operation;
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_OPERATION_FACTORY_H_
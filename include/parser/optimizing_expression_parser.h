@@ -0,0 +1,46 @@
+#ifndef INCLUDE_OPTIMIZING_EXPRESSION_PARSER_H_
+#define INCLUDE_OPTIMIZING_EXPRESSION_PARSER_H_
+
+#include <bytecode/compiled_operation.h>
+#include <memory>
+#include <optimizer/operation_optimizer.h>
+#include <parser/expression_parser.h>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Parser optimizing the operations created by another parser.
+     *
+     * Compiled operations are compiled again after the optimization so that shared operations are evaluated once.
+     *
+     * @tparam T result of the parsed operations
+     */
+    template<typename T>
+    class OptimizingExpressionParser final : public ExpressionParser<T> {
+        std::shared_ptr<ExpressionParser<T>> const parser_;
+
+    public:
+        explicit OptimizingExpressionParser(std::shared_ptr<ExpressionParser<T>> parser) noexcept
+            : parser_(std::move(parser)) {}
+
+        std::shared_ptr<Operation<T>> parse(std::istream& input) override {
+            return optimizeParsed(parser_->parse(input));
+        }
+
+        std::shared_ptr<Operation<T>> parse(std::string_view const& expression) override {
+            return optimizeParsed(parser_->parse(expression));
+        }
+
+    private:
+        static std::shared_ptr<Operation<T>> optimizeParsed(std::shared_ptr<Operation<T>> const& parsed) {
+            auto optimized = optimize(parsed);
+            if (optimized != parsed && std::dynamic_pointer_cast<CompiledOperation<T>>(parsed))
+                return std::make_shared<CompiledOperation<T>>(std::move(optimized));
+
+            return optimized;
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_OPTIMIZING_EXPRESSION_PARSER_H_
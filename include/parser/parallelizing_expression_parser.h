@@ -0,0 +1,33 @@
+#ifndef INCLUDE_PARALLELIZING_EXPRESSION_PARSER_H_
+#define INCLUDE_PARALLELIZING_EXPRESSION_PARSER_H_
+
+#include <concurrent/parallel_sum_operation.h>
+#include <memory>
+#include <parser/expression_parser.h>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Parser making the wide sums of the operations created by another parser evaluated in parallel.
+     *
+     * @see parallelize
+     * @tparam T result of the parsed operations
+     */
+    template<typename T>
+    class ParallelizingExpressionParser final : public ExpressionParser<T> {
+        std::shared_ptr<ExpressionParser<T>> const parser_;
+
+    public:
+        explicit ParallelizingExpressionParser(std::shared_ptr<ExpressionParser<T>> parser) noexcept
+            : parser_(std::move(parser)) {}
+
+        std::shared_ptr<Operation<T>> parse(std::istream& input) override { return parallelize(parser_->parse(input)); }
+
+        std::shared_ptr<Operation<T>> parse(std::string_view const& expression) override {
+            return parallelize(parser_->parse(expression));
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_PARALLELIZING_EXPRESSION_PARSER_H_
@@ -5,10 +5,13 @@
 #include <boost/convert.hpp>
 #include <boost/convert/strtol.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
+#include <bytecode/compiled_operation.h>
 #include <map>
 #include <operation/algebraic_operations.h>
 #include <operation/const_operation.h>
 #include <parser/expression_parser.h>
+#include <parser/number_literal.h>
+#include <parser/operation_factory.h>
 #include <queue>
 #include <stack>
 #include <string_view>
@@ -19,29 +22,18 @@ using BigDecimal = boost::multiprecision::cpp_rational;
 
 namespace calculator {
 
+    /**
+     * @brief Parser building a DAG in which structurally identical sub-expressions are shared.
+     *
+     * If there are any shared sub-expressions the parsed DAG is compiled so that each of them is evaluated once.
+     *
+     * @tparam T result of the parsed operations
+     */
     template<typename T>
     class SimpleOperationParser final : public ExpressionParser<T> {
         typedef std::shared_ptr<Operation<T>> OperationPointer;
 
-        /*
-         * Type conversions
-
-        template<typename C>
-        C fromStringView(std::string_view const& number) {
-            struct None {};
-            static_assert(std::is_same<T, C>::value, "Type is not convertible");
-        }
-
-        template<>
-        double fromStringView<double>(std::string_view const& number) {
-            return boost::convert<double>(number, boost::cnv::strtol());
-        }
-
-        template<>
-        BigDecimal fromStringView<BigDecimal>(std::string_view const& number) {
-            return BigDecimal(number);
-        }
-         */
+        InterningStatistics statistics_{0, 0, 0};
 
         /*
          * Parsing
@@ -79,15 +71,18 @@ namespace calculator {
         struct Context final {
             typedef std::variant<OperationPointer, OperatorType> OperandOrOperator;
 
+            OperationFactory<T>& factory;
             std::queue<OperandOrOperator> output;
             std::stack<Operator> operators;
 
         public:
+            explicit Context(OperationFactory<T>& factory) noexcept : factory(factory) {}
+
             void pushValue(std::shared_ptr<Operation<T>>&& value) { output.push(std::move(value)); }
 
-            void pushConstant(T&& number) { pushValue(std::make_shared<ConstOperation<T>>(std::move(number))); }
+            void pushConstant(T&& number) { pushValue(factory.template create<ConstOperation<T>>(std::move(number))); }
 
-            void pushVariable(char const name) { pushValue(std::make_shared<VariableOperation<T>>(name)); }
+            void pushVariable(char const name) { pushValue(factory.template create<VariableOperation<T>>(name)); }
 
             void pushFunction(OperatorType type) { operators.push({type, INT_MAX, false}); }
 
@@ -124,28 +119,36 @@ namespace calculator {
                 }
             }
 
-            OperationPointer createOperation() {
-                struct Operands {
-                    std::stack<OperationPointer> operands_;
+            struct Operands {
+                std::stack<OperationPointer> operands_;
 
-                    void push(OperationPointer&& operation) { operands_.push(std::move(operation)); }
+                void push(OperationPointer&& operation) { operands_.push(std::move(operation)); }
 
-                    void push(OperationPointer const& operation) { operands_.push(operation); }
+                void push(OperationPointer const& operation) { operands_.push(operation); }
 
-                    OperationPointer pop() {
-                        if (operands_.empty()) throw InvalidExpression("Missing operand for expression");
+                OperationPointer pop() {
+                    if (operands_.empty()) throw InvalidExpression("Missing operand for expression");
 
-                        auto const popped = operands_.top();
-                        operands_.pop();
+                    auto popped = std::move(operands_.top());
+                    operands_.pop();
 
-                        return popped;
-                    }
-                } operands;
+                    return popped;
+                }
+            };
+
+            template<typename O>
+            void pushBinary(Operands& operands) {
+                auto rightOperand = operands.pop(), leftOperand = operands.pop();
+                operands.push(factory.template create<O>(std::move(leftOperand), std::move(rightOperand)));
+            }
+
+            OperationPointer createOperation() {
+                Operands operands;
 
                 if (output.empty()) throw InvalidExpression("An empty sub-expression");
 
                 while (!output.empty()) {
-                    auto const either = output.front();
+                    auto either = std::move(output.front());
                     output.pop();
                     /*
                     std::cout << '(' << (either.index()) << ')'
@@ -153,59 +156,59 @@ namespace calculator {
                                                       : std::get<1>(either))
                               << ' ';
                               */
-                    if (either.index() == 0) operands.push(std::get<0>(either)); // operand
-                    else {                                                       // operator
+                    if (either.index() == 0) operands.push(std::move(std::get<0>(either))); // operand
+                    else {                                                                  // operator
                         switch (std::get<1>(either)) {
                             case OperatorType::LEFT_BRACE: throw InvalidExpression("Imbalanced parentheses");
                             case OperatorType::RIGHT_BRACE:
                                 throw std::runtime_error("Parser has produced a right brace token");
                             case OperatorType::INVERT: {
-                                operands.push(std::make_shared<InvertOperation<T>>(operands.pop()));
+                                operands.push(factory.template create<InvertOperation<T>>(operands.pop()));
                                 break;
                             }
                             case OperatorType::PLUS: {
-                                operands.push(std::make_shared<PlusOperation<T>>(operands.pop(), operands.pop()));
+                                pushBinary<PlusOperation<T>>(operands);
                                 break;
                             }
                             case OperatorType::MINUS: {
-                                operands.push(std::make_shared<MinusOperation<T>>(operands.pop(), operands.pop()));
+                                pushBinary<MinusOperation<T>>(operands);
                                 break;
                             }
                             case OperatorType::MULTIPLY: {
-                                operands.push(std::make_shared<MultiplyOperation<T>>(operands.pop(), operands.pop()));
+                                pushBinary<MultiplyOperation<T>>(operands);
                                 break;
                             }
                             case OperatorType::DIVIDE: {
-                                operands.push(std::make_shared<DivideOperation<T>>(operands.pop(), operands.pop()));
+                                pushBinary<DivideOperation<T>>(operands);
                                 break;
                             }
                             case OperatorType::SQRT: {
-                                operands.push(std::make_shared<PrimitiveSqrtOperation<T>>(operands.pop()));
+                                operands.push(factory.template create<PrimitiveSqrtOperation<T>>(operands.pop()));
                                 break;
                             }
                             case OperatorType::EXP: {
-                                operands.push(std::make_shared<PowOperation<T>>(std::make_shared<ConstEOperation<T>>(),
-                                                                                operands.pop()));
+                                operands.push(factory.template create<PowOperation<T>>(
+                                        factory.template create<ConstEOperation<T>>(), operands.pop()));
                                 break;
                             }
                             case OperatorType::POW: {
-                                operands.push(std::make_shared<PowOperation<T>>(operands.pop(), operands.pop()));
+                                pushBinary<PowOperation<T>>(operands);
                                 break;
                             }
                             case OperatorType::SIN: {
-                                operands.push(std::make_shared<SinOperation<T>>(operands.pop()));
+                                operands.push(factory.template create<SinOperation<T>>(operands.pop()));
                                 break;
                             }
                             case OperatorType::COS: {
-                                operands.push(std::make_shared<CosOperation<T>>(operands.pop()));
+                                operands.push(factory.template create<CosOperation<T>>(operands.pop()));
                                 break;
                             }
                             case OperatorType::TG: {
-                                operands.push(std::make_shared<TgOperation<T>>(operands.pop()));
+                                operands.push(factory.template create<TgOperation<T>>(operands.pop()));
                                 break;
                             }
                             case OperatorType::CTG: {
-                                operands.push(std::make_shared<CtgOperation<T>>(operands.pop()));
+                                operands.push(factory.template create<CtgOperation<T>>(operands.pop()));
                                 break;
                             }
                                 // unsupported
@@ -249,8 +252,9 @@ namespace calculator {
             }
         };
 
-        static std::shared_ptr<Operation<T>> parseExpression(std::string_view expression) {
-            Context context;
+        static std::shared_ptr<Operation<T>> parseExpression(std::string_view expression,
+                                                             OperationFactory<T>& factory) {
+            Context context(factory);
             Permissions permissions;
             permissions.permit(PermittedToken::OPERAND);
 
@@ -287,8 +291,8 @@ namespace calculator {
                             }
                         }
 
-                        // TODO from string
-                        context.pushConstant(T(expression.substr(index + 1 - numberLength, numberLength)));
+                        context.pushConstant(
+                                parseNumberLiteral<T>(expression.substr(index + 1 - numberLength, numberLength)));
                         permissions.permitAnything();
 
                         break;
@@ -309,7 +313,8 @@ namespace calculator {
                         if (numberLength == 1) // no digits
                             throw InvalidExpression("Meaningless dot at index " + std::to_string(index));
 
-                        context.pushConstant(T(expression.substr(index + 1 - numberLength, numberLength)));
+                        context.pushConstant(
+                                parseNumberLiteral<T>(expression.substr(index + 1 - numberLength, numberLength)));
 
                         permissions.clear();
                         permissions.permitAnything();
@@ -341,7 +346,7 @@ namespace calculator {
 
                         permissions.require(PermittedToken::OPERAND);
                         // this is an e constant
-                        context.pushValue(std::make_shared<ConstEOperation<T>>());
+                        context.pushValue(factory.template create<ConstEOperation<T>>());
 
                         permissions.permitAnything();
 
@@ -355,7 +360,7 @@ namespace calculator {
                             if (char1 == 'I' || char1 == 'i') {
                                 // this is a PI const
                                 ++index;
-                                context.pushValue(std::make_shared<ConstPiOperation<T>>());
+                                context.pushValue(factory.template create<ConstPiOperation<T>>());
                                 break;
                             }
                         }
@@ -607,18 +612,18 @@ namespace calculator {
         }
 
         // parses an expression with no possible reordering
-        static OperationPointer parseSingleTermExpression(std::string_view expression) {
-            return parseExpression(expression);
+        static OperationPointer parseSingleTermExpression(std::string_view expression, OperationFactory<T>& factory) {
+            return parseExpression(expression, factory);
         }
 
         // parses an expression with no possible reordering
-        static OperationPointer parseSingleTerm(Term term) {
-            return term.negative ? std::make_shared<NegativeOperation<T>>(parseSingleTermExpression(term.expression))
-                                 : parseSingleTermExpression(term.expression);
+        static OperationPointer parseSingleTerm(Term term, OperationFactory<T>& factory) {
+            auto operation = parseSingleTermExpression(term.expression, factory);
+            return term.negative ? factory.template create<NegativeOperation<T>>(std::move(operation)) : operation;
         }
 
         // parse expression knowing that it itself is a valid term (but may consist of multiple terms)
-        static OperationPointer parseExpressionOfTerm(std::string_view expression) {
+        static OperationPointer parseExpressionOfTerm(std::string_view expression, OperationFactory<T>& factory) {
             auto const terms = splitToTerms(expression);
 
             auto const size = terms.size();
@@ -627,28 +632,32 @@ namespace calculator {
                 case 1: {
                     // todo handle cases like `(((expr)))`
                     auto const term = terms[0];
-                    return parseSingleTerm(term);
+                    return parseSingleTerm(term, factory);
                 }
                 // if there are more than 2 terms then the each may consist of multiple terms
                 case 2: {
                     auto const term1 = terms[0], term2 = terms[1];
-                    return std::make_shared<PlusOperation<T>>(parseTerm(term1), parseTerm(term2));
+                    auto left = parseTerm(term1, factory), right = parseTerm(term2, factory);
+                    return factory.template create<PlusOperation<T>>(std::move(left), std::move(right));
                 }
                 default: {
                     std::vector<OperationPointer> operations(size);
-                    std::transform(terms.begin(), terms.end(), operations.begin(), parseSingleTerm);
+                    std::transform(terms.begin(), terms.end(), operations.begin(),
+                                   [&factory](Term const& term) { return parseSingleTerm(term, factory); });
 
-                    return std::make_shared<VectorSumOperation<T>>(operations);
+                    return factory.template create<VectorSumOperation<T>>(std::move(operations));
                 }
             }
         }
 
-        static OperationPointer parseTerm(Term term) {
-            return term.negative ? std::make_shared<NegativeOperation<T>>(parseExpressionOfTerm(term.expression))
-                                 : parseExpressionOfTerm(term.expression);
+        static OperationPointer parseTerm(Term term, OperationFactory<T>& factory) {
+            auto operation = parseExpressionOfTerm(term.expression, factory);
+            return term.negative ? factory.template create<NegativeOperation<T>>(std::move(operation)) : operation;
         }
 
     public:
+        using ExpressionParser<T>::parse;
+
         virtual OperationPointer parse(std::istream& input) override {
             std::string line;
             getline(input, line);
@@ -657,8 +666,18 @@ namespace calculator {
                 line.erase(std::remove_if(line.begin(), end, isspace), end);
             }
 
-            return parseExpressionOfTerm(line);
+            OperationFactory<T> factory;
+            auto operation = parseExpressionOfTerm(line, factory);
+            statistics_ = factory.statistics();
+
+            return statistics_.shared == 0 ? operation
+                                                 : std::make_shared<CompiledOperation<T>>(std::move(operation));
         }
+
+        /**
+         * @brief Gets the numbers of created, deduplicated and shared operations of the last parsed expression.
+         */
+        InterningStatistics const& statistics() const noexcept { return statistics_; }
     };
 } // namespace calculator
 
@@ -0,0 +1,334 @@
+#ifndef INCLUDE_STATIC_EXPRESSION_PARSER_H_
+#define INCLUDE_STATIC_EXPRESSION_PARSER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <operation/static_operation.h>
+#include <parser/expression_parser.h>
+#include <string_view>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief String literal which can be a template argument.
+     */
+    template<size_t N>
+    struct FixedString {
+        char value[N]{};
+
+        constexpr FixedString(char const (&string)[N]) { std::copy_n(string, N, value); }
+
+        constexpr std::string_view view() const noexcept { return {value, N - 1}; }
+    };
+
+    struct StaticNode {
+        StaticKind kind;
+        uint64_t numerator, denominator; // value of a constant
+        size_t slot;                     // slot of a variable
+        size_t first, count;             // operands
+    };
+
+    template<size_t CAPACITY>
+    struct StaticAst {
+        std::array<StaticNode, CAPACITY> nodes{};
+        std::array<size_t, CAPACITY> operands{};
+        size_t size = 0, operandsSize = 0, root = 0;
+    };
+
+    /**
+     * @brief Parser of expressions known at compile time building their ASTs during the compilation.
+     *
+     * The grammar and the shape of the built AST are those of `LinearExpressionParser`, including the chains of
+     * additions and subtractions collected into sums and small constant powers of leaves turned into products,
+     * so that a static expression computes the same values as the parsed one. Invalid expressions don't compile.
+     *
+     * @tparam CAPACITY maximal number of the nodes of the AST
+     */
+    template<size_t CAPACITY>
+    class StaticExpressionParser final {
+        struct Term {
+            size_t node;
+            bool negative;
+        };
+
+        struct Operand {
+            size_t node;
+            bool chain; // whether it is a parenthesized sum which following terms continue as with the linear parser
+        };
+
+        struct Function {
+            std::string_view name;
+            StaticKind kind;
+        };
+
+        // names sharing a prefix are ordered from the longest one, `exp` is a power of `e`
+        static constexpr Function FUNCTIONS[] = {{"sqrt", StaticKind::SQRT}, {"sin", StaticKind::SIN},
+                                                 {"cos", StaticKind::COS},   {"ctg", StaticKind::CTG},
+                                                 {"tg", StaticKind::TG},     {"exp", StaticKind::POW}};
+
+        std::string_view const expression_;
+        size_t index_ = 0;
+        StaticAst<CAPACITY> ast_;
+        std::array<Term, CAPACITY> terms_{}; // terms of the sums being parsed
+        size_t termsSize_ = 0;
+
+        // not a constant expression so that the compilation fails with the message if it is reached
+        static void fail(char const* const message) { throw InvalidExpression(message); }
+
+        static constexpr bool isDigit(char const character) noexcept { return character >= '0' && character <= '9'; }
+
+        static constexpr char lower(char const character) noexcept {
+            return character >= 'A' && character <= 'Z' ? static_cast<char>(character - 'A' + 'a') : character;
+        }
+
+        static constexpr bool isSpace(char const character) noexcept {
+            return character == ' ' || (character >= '\t' && character <= '\r');
+        }
+
+        constexpr char peek() {
+            while (index_ < expression_.size() && isSpace(expression_[index_])) ++index_;
+
+            return index_ < expression_.size() ? expression_[index_] : '\0';
+        }
+
+        constexpr bool matches(std::string_view const& name) const {
+            if (expression_.size() - index_ < name.size()) return false;
+            for (size_t i = 0; i < name.size(); ++i)
+                if (lower(expression_[index_ + i]) != name[i]) return false;
+
+            return true;
+        }
+
+        constexpr size_t add(StaticNode node, std::initializer_list<size_t> const operands) {
+            return add(node, operands.begin(), operands.size());
+        }
+
+        constexpr size_t add(StaticNode node, size_t const* const operands, size_t const count) {
+            if (ast_.size == CAPACITY || ast_.operandsSize + count > CAPACITY) fail("The expression is too long");
+
+            node.first = ast_.operandsSize;
+            node.count = count;
+            std::copy_n(operands, count, ast_.operands.begin() + ast_.operandsSize);
+            ast_.operandsSize += count;
+            ast_.nodes[ast_.size] = node;
+
+            return ast_.size++;
+        }
+
+        constexpr size_t add(StaticKind const kind, std::initializer_list<size_t> const operands) {
+            return add(StaticNode{kind, 0, 1, 0, 0, 0}, operands);
+        }
+
+        constexpr void pushTerm(size_t const node, bool const negative) {
+            if (termsSize_ == CAPACITY) fail("The expression is too long");
+            terms_[termsSize_++] = {node, negative};
+        }
+
+        // pushes the terms of a sum which is continued
+        constexpr void pushTerms(size_t const sum) {
+            auto const& node = ast_.nodes[sum];
+            for (size_t i = 0; i < node.count; ++i)
+                pushTerm(ast_.operands[node.first + i], node.kind == StaticKind::MINUS && i == 1);
+        }
+
+        // collects the terms pushed since the given index into a node
+        constexpr size_t popTerms(size_t const begin) {
+            auto const count = termsSize_ - begin;
+            auto const terms = terms_.begin() + begin;
+            termsSize_ = begin;
+            if (count == 2)
+                return add(terms[1].negative ? StaticKind::MINUS : StaticKind::PLUS, {terms[0].node, terms[1].node});
+
+            std::array<size_t, CAPACITY> operands{};
+            for (size_t i = 0; i < count; ++i)
+                operands[i] = terms[i].negative ? add(StaticKind::NEGATIVE, {terms[i].node}) : terms[i].node;
+
+            return add(StaticNode{StaticKind::SUM, 0, 1, 0, 0, 0}, operands.data(), count);
+        }
+
+        static constexpr Operand operand(size_t const node) { return {node, false}; }
+
+        constexpr size_t number() {
+            uint64_t numerator = 0, denominator = 1;
+            auto fraction = false, digits = false;
+            for (; index_ < expression_.size(); ++index_) {
+                auto const character = expression_[index_];
+                if (character == ',' && !fraction) {
+                    fraction = true;
+                    continue;
+                }
+                if (!isDigit(character)) break;
+
+                if (numerator > (std::numeric_limits<uint64_t>::max() - 9) / 10
+                    || (fraction && denominator > std::numeric_limits<uint64_t>::max() / 10))
+                    fail("The number has too many digits for a static expression");
+                numerator = numerator * 10 + static_cast<uint64_t>(character - '0');
+                if (fraction) denominator *= 10;
+                digits = true;
+            }
+            if (!digits || expression_[index_ - 1] == ',') fail("Meaningless comma in a number");
+
+            return add(StaticNode{StaticKind::CONSTANT, numerator, denominator, 0, 0, 0}, {});
+        }
+
+        constexpr Operand primary() {
+            auto const character = peek();
+            if (isDigit(character) || character == ',') return operand(number());
+            if (character == '(') {
+                ++index_;
+                auto const sum = this->sum();
+                if (peek() != ')') fail("Imbalanced parentheses in expression");
+                ++index_;
+
+                return sum;
+            }
+            if (!((character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z')))
+                fail("Unexpected symbol where an operand is expected");
+
+            if (matches("pi")) {
+                index_ += 2;
+                return operand(add(StaticKind::PI, {}));
+            }
+            ++index_;
+            if (character == 'e' || character == 'E') return operand(add(StaticKind::E, {}));
+
+            return operand(add(StaticNode{StaticKind::VARIABLE, 0, 1, Variables<double>::slotOf(character), 0, 0}, {}));
+        }
+
+        // functions are applied to the nearest operand unless it starts with a minus
+        constexpr Operand application() {
+            peek();
+            for (auto const& function : FUNCTIONS)
+                if (matches(function.name)) {
+                    index_ += function.name.size();
+                    while (peek() == '+') ++index_; // unary plus changes nothing
+                    auto const argument = (peek() == '-' ? negation() : application()).node;
+                    if (function.kind == StaticKind::POW)
+                        return operand(add(StaticKind::POW, {add(StaticKind::E, {}), argument}));
+
+                    return operand(add(function.kind, {argument}));
+                }
+
+            return primary();
+        }
+
+        // `^` is right-associative and binds tighter than the unary minus
+        constexpr Operand power() {
+            auto const base = application();
+            if (peek() != '^') return base;
+
+            ++index_;
+            auto const baseNode = base.node, exponentNode = negation().node;
+            auto const& baseValue = ast_.nodes[baseNode];
+            auto const& exponent = ast_.nodes[exponentNode];
+            auto const leaf = baseValue.kind == StaticKind::CONSTANT || baseValue.kind == StaticKind::VARIABLE;
+            if (leaf && exponent.kind == StaticKind::CONSTANT
+                && (exponent.numerator == 2 * exponent.denominator || exponent.numerator == 3 * exponent.denominator)) {
+                auto const cube = exponent.numerator == 3 * exponent.denominator;
+                auto const square = add(StaticKind::MULTIPLY, {baseNode, baseNode});
+                return operand(cube ? add(StaticKind::MULTIPLY, {square, baseNode}) : square);
+            }
+
+            return operand(add(StaticKind::POW, {baseNode, exponentNode}));
+        }
+
+        constexpr Operand negation() {
+            switch (peek()) {
+                case '-': {
+                    ++index_;
+                    return operand(add(StaticKind::NEGATIVE, {negation().node}));
+                }
+                case '+': { // unary plus changes nothing
+                    ++index_;
+                    return negation();
+                }
+                default: return power();
+            }
+        }
+
+        constexpr Operand product() {
+            auto left = negation();
+            for (auto character = peek(); character == '*' || character == '/'; character = peek()) {
+                ++index_;
+                auto const kind = character == '*' ? StaticKind::MULTIPLY : StaticKind::DIVIDE;
+                auto const leftNode = left.node;
+                left = operand(add(kind, {leftNode, negation().node}));
+            }
+
+            return left;
+        }
+
+        constexpr Operand sum() {
+            auto const first = product();
+            if (peek() != '+' && peek() != '-') return first;
+
+            auto const begin = termsSize_;
+            if (first.chain) pushTerms(first.node);
+            else pushTerm(first.node, false);
+            for (auto character = peek(); character == '+' || character == '-'; character = peek()) {
+                ++index_;
+                pushTerm(product().node, character == '-');
+            }
+
+            return {popTerms(begin), true};
+        }
+
+    public:
+        explicit constexpr StaticExpressionParser(std::string_view const& expression) : expression_(expression) {}
+
+        /**
+         * @brief Parses the expression, it doesn't compile if the expression is invalid.
+         */
+        constexpr StaticAst<CAPACITY> parse() {
+            if (peek() == '\0') fail("The expression is empty");
+            ast_.root = sum().node;
+            if (peek() != '\0') fail(peek() == ')' ? "Imbalanced parentheses in expression"
+                                                   : "Unexpected symbol where an operator is expected");
+
+            return ast_;
+        }
+    };
+
+    template<auto const& AST, size_t INDEX, typename = std::make_index_sequence<AST.nodes[INDEX].count>>
+    struct StaticOperationOf;
+
+    template<auto const& AST, size_t INDEX, size_t... OPERANDS>
+    struct StaticOperationOf<AST, INDEX, std::index_sequence<OPERANDS...>> {
+        static constexpr StaticNode NODE = AST.nodes[INDEX];
+
+        typedef StaticOperation<NODE.kind, NODE.numerator, NODE.denominator, NODE.slot,
+                                typename StaticOperationOf<AST, AST.operands[NODE.first + OPERANDS]>::type...>
+                type;
+    };
+
+    // each character adds at most two nodes
+    template<FixedString EXPRESSION>
+    inline constexpr auto STATIC_AST =
+            StaticExpressionParser<2 * sizeof(EXPRESSION.value) + 2>(EXPRESSION.view()).parse();
+
+    /**
+     * @brief Static operation of an expression parsed during the compilation.
+     *
+     * `StaticExpression<"x^2 + sin x">::result<double>(variables)` computes the same value as the result
+     * of the operation parsed by `LinearExpressionParser` with no parsing, virtual calls or allocations.
+     */
+    template<FixedString EXPRESSION>
+    using StaticExpression = typename StaticOperationOf<STATIC_AST<EXPRESSION>, STATIC_AST<EXPRESSION>.root>::type;
+
+    namespace literals {
+
+        /**
+         * @brief Gets the static operation of the expression, e.g. `"x^2 + 1"_expression.result<double>(variables)`.
+         */
+        template<FixedString EXPRESSION>
+        constexpr StaticExpression<EXPRESSION> operator""_expression() noexcept {
+            return {};
+        }
+    } // namespace literals
+} // namespace calculator
+
+#endif //INCLUDE_STATIC_EXPRESSION_PARSER_H_
@@ -0,0 +1,37 @@
+#ifndef INCLUDE_TIERING_EXPRESSION_PARSER_H_
+#define INCLUDE_TIERING_EXPRESSION_PARSER_H_
+
+#include <bytecode/tiered_operation.h>
+#include <memory>
+#include <parser/expression_parser.h>
+#include <utility>
+
+namespace calculator {
+
+    /**
+     * @brief Parser wrapping the operations created by another parser into `TieredOperation`s.
+     *
+     * Placed under a `CachingExpressionParser` it makes the tiered program of an expression
+     * compiled once for all the evaluations of its cached operation.
+     *
+     * @tparam T result of the parsed operations
+     */
+    template<typename T>
+    class TieringExpressionParser final : public ExpressionParser<T> {
+        std::shared_ptr<ExpressionParser<T>> const parser_;
+
+    public:
+        explicit TieringExpressionParser(std::shared_ptr<ExpressionParser<T>> parser) noexcept
+            : parser_(std::move(parser)) {}
+
+        std::shared_ptr<Operation<T>> parse(std::istream& input) override {
+            return std::make_shared<TieredOperation<T>>(parser_->parse(input));
+        }
+
+        std::shared_ptr<Operation<T>> parse(std::string_view const& expression) override {
+            return std::make_shared<TieredOperation<T>>(parser_->parse(expression));
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_TIERING_EXPRESSION_PARSER_H_
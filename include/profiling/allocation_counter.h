@@ -0,0 +1,65 @@
+#ifndef INCLUDE_ALLOCATION_COUNTER_H_
+#define INCLUDE_ALLOCATION_COUNTER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace calculator {
+
+    /**
+     * @brief Counter of the allocations made by the current thread.
+     *
+     * Allocations are only counted if exactly one translation unit of the program defines
+     * `CALCULATOR_COUNT_ALLOCATIONS` before including this header, which replaces the global `operator new`.
+     * Programs which don't do this keep the standard allocation functions and pay nothing for the counter.
+     */
+    class AllocationCounter final {
+        static inline thread_local uint64_t allocations_ = 0;
+        static inline std::atomic<bool> counting_{false};
+
+    public:
+        /**
+         * @brief Gets the number of the allocations made by the current thread so far.
+         */
+        static uint64_t allocations() noexcept { return allocations_; }
+
+        /**
+         * @brief Checks whether the allocations are counted by the program.
+         */
+        static bool counting() noexcept { return counting_.load(std::memory_order_relaxed); }
+
+        static void count() noexcept { ++allocations_; }
+
+        static bool enable() noexcept {
+            counting_.store(true, std::memory_order_relaxed);
+            return true;
+        }
+    };
+} // namespace calculator
+
+#ifdef CALCULATOR_COUNT_ALLOCATIONS
+
+[[maybe_unused]] static bool const ALLOCATIONS_COUNTED = calculator::AllocationCounter::enable();
+
+void* operator new(std::size_t const size) {
+    calculator::AllocationCounter::count();
+    if (auto const pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t const size) { return operator new(size); }
+
+// not inlined so that compilers don't see `free` of the pointers of `new` expressions
+[[gnu::noinline]] void operator delete(void* const pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* const pointer) noexcept { operator delete(pointer); }
+
+void operator delete(void* const pointer, std::size_t) noexcept { operator delete(pointer); }
+
+void operator delete[](void* const pointer, std::size_t) noexcept { operator delete(pointer); }
+
+#endif //CALCULATOR_COUNT_ALLOCATIONS
+
+#endif //INCLUDE_ALLOCATION_COUNTER_H_
@@ -0,0 +1,269 @@
+#ifndef INCLUDE_EVALUATION_PROFILER_H_
+#define INCLUDE_EVALUATION_PROFILER_H_
+
+#include <atomic>
+#include <boost/core/demangle.hpp>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <operation/operation_operands.h>
+#include <operation/operation_transformer.h>
+#include <ostream>
+#include <profiling/allocation_counter.h>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace calculator {
+
+    /**
+     * @brief Statistics of the evaluations of one node of a profiled operation.
+     *
+     * Total values include those of the operands while self values don't.
+     */
+    struct ProfileNode {
+        std::string label;
+        std::vector<size_t> operands;
+        std::atomic<uint64_t> calls{0}, nanoseconds{0}, selfNanoseconds{0}, allocations{0}, selfAllocations{0};
+
+        ProfileNode(std::string label, std::vector<size_t> operands)
+            : label(std::move(label)), operands(std::move(operands)) {}
+    };
+
+    /**
+     * @brief Statistics of the nodes of a profiled operation, the root is the last node.
+     *
+     * A node shared by several parents is reported under the first of them in the depth-first order.
+     */
+    class EvaluationProfile final {
+        static constexpr size_t NO_PARENT = SIZE_MAX;
+
+        std::deque<ProfileNode> nodes_;
+
+        static double milliseconds(uint64_t const nanoseconds) { return double(nanoseconds) / 1e6; }
+
+        void findParents(size_t const index, std::vector<size_t>& parents) const {
+            for (auto const operand : nodes_[index].operands)
+                if (parents[operand] == NO_PARENT) {
+                    parents[operand] = index;
+                    findParents(operand, parents);
+                }
+        }
+
+        // the first parents of the nodes in the depth-first order
+        std::vector<size_t> parents() const {
+            std::vector<size_t> parents(nodes_.size(), NO_PARENT);
+            if (!nodes_.empty()) {
+                parents[root()] = root();
+                findParents(root(), parents);
+                parents[root()] = NO_PARENT;
+            }
+
+            return parents;
+        }
+
+        void writeTree(std::ostream& output, size_t const index, size_t const depth, std::vector<bool>& written) const {
+            auto const& node = nodes_[index];
+            output << std::string(2 * depth, ' ') << node.label;
+            if (written[index]) {
+                output << " (shared, see above)\n";
+                return;
+            }
+            written[index] = true;
+
+            output << " [calls " << node.calls << ", total " << milliseconds(node.nanoseconds) << " ms, self "
+                   << milliseconds(node.selfNanoseconds) << " ms";
+            if (AllocationCounter::counting())
+                output << ", allocations " << node.allocations << ", self " << node.selfAllocations;
+            output << "]\n";
+            for (auto const operand : node.operands) writeTree(output, operand, depth + 1, written);
+        }
+
+        std::string stackOf(size_t const index, std::vector<size_t> const& parents) const {
+            auto frame = nodes_[index].label;
+            for (auto& character : frame)
+                if (character == ';') character = ',';
+
+            return parents[index] == NO_PARENT ? frame : stackOf(parents[index], parents) + ';' + frame;
+        }
+
+    public:
+        std::deque<ProfileNode> const& nodes() const noexcept { return nodes_; }
+
+        ProfileNode& node(size_t const index) noexcept { return nodes_[index]; }
+
+        size_t root() const noexcept { return nodes_.size() - 1; }
+
+        size_t add(std::string label, std::vector<size_t> operands) {
+            auto const index = nodes_.size();
+            nodes_.emplace_back(std::move(label), std::move(operands));
+
+            return index;
+        }
+
+        void reset() noexcept {
+            for (auto& node : nodes_) {
+                node.calls = 0;
+                node.nanoseconds = 0;
+                node.selfNanoseconds = 0;
+                node.allocations = 0;
+                node.selfAllocations = 0;
+            }
+        }
+
+        /**
+         * @brief Writes the operation as a tree whose nodes are annotated by their statistics.
+         *
+         * Shared nodes are written in full under their first parent only.
+         */
+        void writeTree(std::ostream& output) const {
+            std::vector<bool> written(nodes_.size());
+            if (!nodes_.empty()) writeTree(output, root(), 0, written);
+        }
+
+        /**
+         * @brief Writes the self times of the nodes in nanoseconds as folded stacks of flame graphs.
+         *
+         * A shared node is attributed to the path through its first parent.
+         */
+        void writeFolded(std::ostream& output) const {
+            auto const parents = this->parents();
+            for (size_t index = 0; index < nodes_.size(); ++index)
+                if (nodes_[index].calls != 0)
+                    output << stackOf(index, parents) << ' ' << nodes_[index].selfNanoseconds << '\n';
+        }
+    };
+
+    /**
+     * @brief Operation recording the statistics of the evaluations of its source operation.
+     *
+     * Visitors are passed to the source operation so this one is transparent for them.
+     *
+     * @tparam T result of the operation
+     */
+    template<typename T>
+    class ProfiledOperation final : public Operation<T> {
+        // totals of the operands evaluated by the current node of the current thread
+        struct Frame {
+            uint64_t nanoseconds, allocations;
+        };
+
+        static inline thread_local Frame frame_{0, 0};
+
+        std::shared_ptr<Operation<T>> const source_;
+        std::shared_ptr<EvaluationProfile> const profile_;
+        ProfileNode& node_;
+
+        class Measurement final {
+            ProfileNode& node_;
+            Frame const outer_;
+            uint64_t const allocations_;
+            std::chrono::steady_clock::time_point const start_;
+
+        public:
+            explicit Measurement(ProfileNode& node) noexcept
+                : node_(node), outer_(std::exchange(frame_, {0, 0})), allocations_(AllocationCounter::allocations()),
+                  start_(std::chrono::steady_clock::now()) {}
+
+            Measurement(Measurement const&) = delete;
+
+            Measurement& operator=(Measurement const&) = delete;
+
+            ~Measurement() {
+                auto const elapsed = std::chrono::steady_clock::now() - start_;
+                uint64_t const nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+                auto const allocations = AllocationCounter::allocations() - allocations_;
+                node_.calls.fetch_add(1, std::memory_order_relaxed);
+                node_.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+                node_.selfNanoseconds.fetch_add(nanoseconds - frame_.nanoseconds, std::memory_order_relaxed);
+                node_.allocations.fetch_add(allocations, std::memory_order_relaxed);
+                node_.selfAllocations.fetch_add(allocations - frame_.allocations, std::memory_order_relaxed);
+                frame_ = {outer_.nanoseconds + nanoseconds, outer_.allocations + allocations};
+            }
+        };
+
+    public:
+        ProfiledOperation(std::shared_ptr<Operation<T>> source, std::shared_ptr<EvaluationProfile> profile,
+                          size_t const node)
+            : source_(std::move(source)), profile_(std::move(profile)), node_(profile_->node(node)) {}
+
+        std::shared_ptr<Operation<T>> const& source() const noexcept { return source_; }
+
+        T result(Variables<T> const& variables) const override {
+            Measurement const measurement(node_);
+            return source_->result(variables);
+        }
+
+        void accept(OperationVisitor<T>& visitor) const override { source_->accept(visitor); }
+    };
+
+    /**
+     * @brief Transformer wrapping every operation into a profiled one.
+     *
+     * @tparam T result of the transformed operations
+     */
+    template<typename T>
+    class OperationProfiler final : public OperationTransformer<T> {
+        typedef typename OperationTransformer<T>::OperationPointer OperationPointer;
+
+        std::shared_ptr<EvaluationProfile> const profile_ = std::make_shared<EvaluationProfile>();
+        std::unordered_map<Operation<T> const*, size_t> nodes_; // nodes of the profiled operations
+
+        static std::string labelOf(Operation<T> const& operation) {
+            auto label = boost::core::demangle(typeid(operation).name());
+            label = label.substr(0, label.find('<'));
+            label = label.substr(label.rfind(':') + 1);
+
+            if (auto const variable = dynamic_cast<VariableOperation<T> const*>(&operation))
+                return label + ' ' + variable->name();
+            if (auto const constant = dynamic_cast<ConstOperation<T> const*>(&operation)) {
+                std::ostringstream value;
+                value << constant->value();
+                return label + ' ' + value.str();
+            }
+
+            return label;
+        }
+
+    protected:
+        OperationPointer transformed(OperationPointer const& operation, OperationPointer const& parent,
+                                     OperationPointer&& result) override {
+            std::vector<size_t> operands;
+            for (auto const& operand : operandsOf(*result)) operands.push_back(nodes_.at(operand.get()));
+
+            auto const node = profile_->add(labelOf(*result), std::move(operands));
+            auto profiled = std::make_shared<ProfiledOperation<T>>(std::move(result), profile_, node);
+            nodes_.emplace(profiled.get(), node);
+
+            return profiled;
+        }
+
+    public:
+        std::shared_ptr<EvaluationProfile> const& profile() const noexcept { return profile_; }
+    };
+
+    template<typename T>
+    struct Profiled {
+        std::shared_ptr<Operation<T>> operation;
+        std::shared_ptr<EvaluationProfile> profile;
+    };
+
+    /**
+     * @brief Gets a copy of the operation which records the statistics of the evaluations of its nodes.
+     *
+     * The operation itself is left as is so it is evaluated with no overhead.
+     */
+    template<typename T>
+    Profiled<T> profile(std::shared_ptr<Operation<T>> const& operation) {
+        OperationProfiler<T> profiler;
+        auto profiled = profiler.transform(operation);
+
+        return {std::move(profiled), profiler.profile()};
+    }
+} // namespace calculator
+
+#endif //INCLUDE_EVALUATION_PROFILER_H_
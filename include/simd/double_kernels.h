@@ -0,0 +1,504 @@
+#ifndef INCLUDE_DOUBLE_KERNELS_H_
+#define INCLUDE_DOUBLE_KERNELS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <operation/algebraic_operations.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CALCULATOR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace calculator {
+
+    enum class InstructionSet : uint8_t { SCALAR, SSE2, AVX2 };
+
+    /**
+     * @brief Kernels applying the double-precision operations to whole arrays of values in place
+     * using the widest instruction set available at runtime.
+     *
+     * Lanes for which the polynomial approximations are not accurate (huge or non-finite arguments,
+     * unusual bases and exponents of powers) are recomputed by the scalar operations.
+     */
+    class SimdDoubleKernels final {
+        static InstructionSet detectInstructionSet() noexcept {
+#ifdef CALCULATOR_SIMD_X86
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? InstructionSet::AVX2 : InstructionSet::SSE2;
+#else
+            return InstructionSet::SCALAR;
+#endif
+        }
+
+        static std::atomic<InstructionSet>& selectedInstructionSet() noexcept {
+            static std::atomic<InstructionSet> instructionSet(supportedInstructionSet());
+            return instructionSet;
+        }
+
+        template<typename O>
+        static void scalarUnary(double* const values, size_t const count) {
+            for (size_t i = 0; i < count; ++i) values[i] = O::compute(values[i]);
+        }
+
+        template<typename O>
+        static void scalarBinary(double* const left, double const* const right, size_t const count) {
+            for (size_t i = 0; i < count; ++i) left[i] = O::compute(left[i], right[i]);
+        }
+
+#ifdef CALCULATOR_SIMD_X86
+#define CALCULATOR_SIMD_INLINE [[gnu::always_inline]] static inline
+
+        // wide vectors are passed by reference only since the helpers are shared by the SSE2 and AVX2 code
+        template<size_t W>
+        struct Lanes {
+            static constexpr size_t WIDTH = W;
+
+            typedef double Values __attribute__((vector_size(W * sizeof(double))));
+            typedef int64_t Bits __attribute__((vector_size(W * sizeof(double))));
+        };
+
+        static constexpr double ROUNDING_MAGIC = 0x1.8p52;
+
+        // rounds to the nearest integer which is also returned as bits, valid for |x| < 2^51
+        template<typename L>
+        CALCULATOR_SIMD_INLINE void round(typename L::Values const& x, typename L::Values& rounded,
+                                          typename L::Bits& integer) {
+            typedef typename L::Bits Bits;
+            typedef typename L::Values Values;
+            Values const shifted = x + ROUNDING_MAGIC;
+            integer = (Bits) shifted - (Bits)(Values{} + ROUNDING_MAGIC);
+            rounded = shifted - ROUNDING_MAGIC;
+        }
+
+        /*
+         * Trigonometry: Cody-Waite reduction by pi/2 and fdlibm kernels on [-pi/4; pi/4]
+         */
+
+        static constexpr double TRIGONOMETRY_LIMIT = 1e5;
+
+        template<typename L>
+        CALCULATOR_SIMD_INLINE void reduceQuadrant(typename L::Values const& x, typename L::Values& sin,
+                                                   typename L::Values& cos, typename L::Bits& quadrant,
+                                                   typename L::Bits& fallback) {
+            typedef typename L::Bits Bits;
+            typedef typename L::Values Values;
+            // NaNs fail the comparison so they also fall back
+            fallback = ~((x < TRIGONOMETRY_LIMIT) & (x > -TRIGONOMETRY_LIMIT));
+            Values const argument = fallback ? Values{} : x;
+
+            Values q;
+            Bits integer;
+            round<L>(argument * 6.36619772367581382433e-01, q, integer);
+            quadrant = integer & 3;
+            auto const r = (((argument - q * 1.57079632673412561417e+00) - q * 6.07710050630396597660e-11)
+                            - q * 2.02226624871116645580e-21)
+                           - q * 8.47842766036889956997e-32;
+
+            auto const z = r * r;
+            auto sinPolynomial = z * 1.58969099521155010221e-10 - 2.50507602534068634195e-08;
+            sinPolynomial = sinPolynomial * z + 2.75573137070700676789e-06;
+            sinPolynomial = sinPolynomial * z - 1.98412698298579493134e-04;
+            sinPolynomial = sinPolynomial * z + 8.33333333332248946124e-03;
+            sinPolynomial = sinPolynomial * z - 1.66666666666666324348e-01;
+            sin = z == 0. ? r : r + r * z * sinPolynomial; // keeps the sign of zero
+
+            auto cosPolynomial = z * -1.13596475577881948265e-11 + 2.08757232129817482790e-09;
+            cosPolynomial = cosPolynomial * z - 2.75573143513906633035e-07;
+            cosPolynomial = cosPolynomial * z + 2.48015872894767294178e-05;
+            cosPolynomial = cosPolynomial * z - 1.38888888888741095749e-03;
+            cosPolynomial = cosPolynomial * z + 4.16666666666666019037e-02;
+            cos = 1. - .5 * z + z * z * cosPolynomial;
+        }
+
+        struct Sin {
+            static double compute(double const value) { return SinOperation<double>::compute(value); }
+
+            template<typename L>
+            CALCULATOR_SIMD_INLINE void apply(typename L::Values const& x, typename L::Values& result,
+                                              typename L::Bits& fallback) {
+                typename L::Values sin, cos;
+                typename L::Bits quadrant;
+                reduceQuadrant<L>(x, sin, cos, quadrant, fallback);
+                // sin, cos, -sin, -cos
+                result = (quadrant & 1) != 0 ? cos : sin;
+                result = (quadrant & 2) != 0 ? -result : result;
+            }
+        };
+
+        struct Cos {
+            static double compute(double const value) { return CosOperation<double>::compute(value); }
+
+            template<typename L>
+            CALCULATOR_SIMD_INLINE void apply(typename L::Values const& x, typename L::Values& result,
+                                              typename L::Bits& fallback) {
+                typename L::Values sin, cos;
+                typename L::Bits quadrant;
+                reduceQuadrant<L>(x, sin, cos, quadrant, fallback);
+                // cos, -sin, -cos, sin
+                result = (quadrant & 1) != 0 ? sin : cos;
+                result = ((quadrant + 1) & 2) != 0 ? -result : result;
+            }
+        };
+
+        struct Tg {
+            static double compute(double const value) { return TgOperation<double>::compute(value); }
+
+            template<typename L>
+            CALCULATOR_SIMD_INLINE void apply(typename L::Values const& x, typename L::Values& result,
+                                              typename L::Bits& fallback) {
+                typename L::Values sin, cos;
+                typename L::Bits quadrant;
+                reduceQuadrant<L>(x, sin, cos, quadrant, fallback);
+                auto const odd = (quadrant & 1) != 0;
+                result = (odd ? -cos : sin) / (odd ? sin : cos);
+            }
+        };
+
+        struct Ctg {
+            static double compute(double const value) { return CtgOperation<double>::compute(value); }
+
+            template<typename L>
+            CALCULATOR_SIMD_INLINE void apply(typename L::Values const& x, typename L::Values& result,
+                                              typename L::Bits& fallback) {
+                typename L::Values sin, cos;
+                typename L::Bits quadrant;
+                reduceQuadrant<L>(x, sin, cos, quadrant, fallback);
+                auto const odd = (quadrant & 1) != 0;
+                result = (odd ? -sin : cos) / (odd ? cos : sin);
+            }
+        };
+
+        /*
+         * Exponentiation: pow(a, y) = exp(y * log(a)) with the product kept in double-double
+         */
+
+        static constexpr double LN2_HIGH = 6.93147180369123816490e-01, LN2_LOW = 1.90821492927058770002e-10,
+                                EXP_MIN = -708., EXP_MAX = 709.;
+
+        // exp(high + low) for EXP_MIN <= high <= EXP_MAX and a tiny low
+        template<typename L>
+        CALCULATOR_SIMD_INLINE void exp(typename L::Values const& high, typename L::Values const& low,
+                                        typename L::Values& result) {
+            typedef typename L::Values Values;
+            Values kd;
+            typename L::Bits k;
+            round<L>(high * 1.44269504088896338700e+00, kd, k);
+            auto const r = (high - kd * LN2_HIGH) - kd * LN2_LOW + low;
+
+            // Taylor series of degree 13 is exact to double precision for |r| <= ln(2) / 2
+            auto p = r * (1. / 6227020800.) + 1. / 479001600.;
+            p = p * r + 1. / 39916800.;
+            p = p * r + 1. / 3628800.;
+            p = p * r + 1. / 362880.;
+            p = p * r + 1. / 40320.;
+            p = p * r + 1. / 5040.;
+            p = p * r + 1. / 720.;
+            p = p * r + 1. / 120.;
+            p = p * r + 1. / 24.;
+            p = p * r + 1. / 6.;
+            p = p * r + .5;
+            p = p * r + 1.;
+            p = p * r + 1.;
+
+            result = p * (Values)((k + 1023) << 52); // scaled by 2^k
+        }
+
+        // log(a) = exponent * LN2_HIGH + rest, the first part is exact, valid for normal positive a
+        template<typename L>
+        CALCULATOR_SIMD_INLINE void log(typename L::Values const& a, typename L::Values& exponentPart,
+                                        typename L::Values& rest) {
+            typedef typename L::Bits Bits;
+            typedef typename L::Values Values;
+            auto const bits = (Bits) a;
+            auto exponent = ((bits >> 52) & 0x7ff) - 1023;
+            auto m = (Values)((bits & 0x000fffffffffffffL) | 0x3ff0000000000000L); // [1; 2)
+            auto const large = m > 1.41421356237309514547;
+            m = large ? m * .5 : m;
+            exponent -= large; // true is -1
+            auto const e = (Values)(exponent + (Bits)(Values{} + ROUNDING_MAGIC)) - ROUNDING_MAGIC;
+
+            auto const f = m - 1.;
+            auto const s = f / (2. + f);
+            auto const z = s * s, w = z * z;
+            auto const t1 =
+                    w * (3.999999999940941908e-01 + w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+            auto const t2 = z
+                            * (6.666666666666735130e-01
+                               + w * (2.857142874366239149e-01
+                                      + w * (1.818357216161805012e-01 + w * 1.479819860511658591e-01)));
+            auto const halfSquare = .5 * f * f;
+
+            exponentPart = e * LN2_HIGH;
+            rest = e * LN2_LOW + (f - (halfSquare - s * (halfSquare + t1 + t2)));
+        }
+
+        // exact sum split into high and low parts (Knuth)
+        template<typename L>
+        CALCULATOR_SIMD_INLINE void addExactly(typename L::Values const& a, typename L::Values const& b,
+                                               typename L::Values& high, typename L::Values& low) {
+            high = a + b;
+            auto const bPart = high - a;
+            low = (a - (high - bPart)) + (b - bPart);
+        }
+
+        // exact product split into high and low parts (Dekker)
+        template<typename L>
+        CALCULATOR_SIMD_INLINE void multiplyExactly(typename L::Values const& a, typename L::Values const& b,
+                                                    typename L::Values& high, typename L::Values& low) {
+            auto const ca = a * 134217729., cb = b * 134217729.;
+            auto const aHigh = ca - (ca - a), aLow = a - aHigh;
+            auto const bHigh = cb - (cb - b), bLow = b - bHigh;
+            high = a * b;
+            low = ((aHigh * bHigh - high) + aHigh * bLow + aLow * bHigh) + aLow * bLow;
+        }
+
+        struct Pow {
+            static double compute(double const left, double const right) {
+                return PowOperation<double>::compute(left, right);
+            }
+
+            template<typename L>
+            CALCULATOR_SIMD_INLINE void apply(typename L::Values const& a, typename L::Values const& y,
+                                              typename L::Values& result, typename L::Bits& fallback) {
+                typedef typename L::Values Values;
+                Values const zero{}, one = zero + 1.;
+
+                // powers of e (`exp x`) and small integral exponents are computed by the scalar operation
+                // so that their results are the same as those of the other evaluators
+                auto const scalar = (a == M_E) | (y == 2.) | (y == 3.);
+                auto const logarithmic = ~scalar & (a >= 2.2250738585072014e-308) & (a < INFINITY) & (y >= -4.)
+                                         & (y <= 4.);
+
+                Values exponentPart, rest;
+                log<L>(logarithmic ? a : one, exponentPart, rest);
+                Values exponentHigh, exponentLow, restHigh, restLow, high, low;
+                multiplyExactly<L>(y, exponentPart, exponentHigh, exponentLow);
+                multiplyExactly<L>(y, rest, restHigh, restLow);
+                addExactly<L>(exponentHigh, restHigh, high, low);
+                low += exponentLow + restLow;
+
+                auto const exponential = logarithmic & (high >= EXP_MIN) & (high <= EXP_MAX);
+                exp<L>(exponential ? high : zero, exponential ? low : zero, result);
+
+                // exact cases which `pow` computes in the same way
+                result = y == 1. ? a : result;
+                result = y == 0. ? one : result;
+                fallback = ~(exponential | (y == 0.) | (y == 1.));
+            }
+        };
+
+        // processes a single pack of which only the first lanes are used, the constant full width is loaded directly
+        template<typename L, typename O>
+        CALCULATOR_SIMD_INLINE void unaryPack(double* const values, size_t const lanes) {
+            typename L::Values x{}, result;
+            typename L::Bits fallback;
+            std::memcpy(&x, values, lanes * sizeof(double));
+            O::template apply<L>(x, result, fallback);
+            std::memcpy(values, &result, lanes * sizeof(double));
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+                if (fallback[lane]) values[lane] = O::compute(x[lane]);
+        }
+
+        template<typename L, typename O>
+        CALCULATOR_SIMD_INLINE void binaryPack(double* const left, double const* const right, size_t const lanes) {
+            typename L::Values x{}, y{}, result;
+            typename L::Bits fallback;
+            std::memcpy(&x, left, lanes * sizeof(double));
+            std::memcpy(&y, right, lanes * sizeof(double));
+            O::template apply<L>(x, y, result, fallback);
+            std::memcpy(left, &result, lanes * sizeof(double));
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+                if (fallback[lane]) left[lane] = O::compute(x[lane], y[lane]);
+        }
+
+        template<typename L, typename O>
+        CALCULATOR_SIMD_INLINE void unary(double* const values, size_t const count) {
+            size_t offset = 0;
+            for (; offset + L::WIDTH <= count; offset += L::WIDTH) unaryPack<L, O>(values + offset, L::WIDTH);
+            if (offset < count) unaryPack<L, O>(values + offset, count - offset);
+        }
+
+        template<typename L, typename O>
+        CALCULATOR_SIMD_INLINE void binary(double* const left, double const* const right, size_t const count) {
+            size_t offset = 0;
+            for (; offset + L::WIDTH <= count; offset += L::WIDTH)
+                binaryPack<L, O>(left + offset, right + offset, L::WIDTH);
+            if (offset < count) binaryPack<L, O>(left + offset, right + offset, count - offset);
+        }
+
+        template<typename L>
+        CALCULATOR_SIMD_INLINE void divide(double* const left, double const* const right, size_t const count) {
+            typedef typename L::Values Values;
+            size_t offset = 0;
+            for (; offset + L::WIDTH <= count; offset += L::WIDTH) {
+                Values x, y;
+                std::memcpy(&x, left + offset, sizeof x);
+                std::memcpy(&y, right + offset, sizeof y);
+                x /= y;
+                std::memcpy(left + offset, &x, sizeof x);
+            }
+            for (; offset < count; ++offset) left[offset] /= right[offset];
+        }
+
+        template<typename O>
+        __attribute__((target("avx2"))) static void unaryAvx2(double* const values, size_t const count) {
+            unary<Lanes<4>, O>(values, count);
+        }
+
+        template<typename O>
+        static void unarySse2(double* const values, size_t const count) {
+            unary<Lanes<2>, O>(values, count);
+        }
+
+        template<typename O>
+        __attribute__((target("avx2"))) static void binaryAvx2(double* const left, double const* const right,
+                                                               size_t const count) {
+            binary<Lanes<4>, O>(left, right, count);
+        }
+
+        template<typename O>
+        static void binarySse2(double* const left, double const* const right, size_t const count) {
+            binary<Lanes<2>, O>(left, right, count);
+        }
+
+        __attribute__((target("avx2"))) static void divideAvx2(double* const left, double const* const right,
+                                                               size_t const count) {
+            divide<Lanes<4>>(left, right, count);
+        }
+
+        static void divideSse2(double* const left, double const* const right, size_t const count) {
+            divide<Lanes<2>>(left, right, count);
+        }
+
+        __attribute__((target("avx2"))) static void sqrtAvx2(double* const values, size_t const count) {
+            size_t offset = 0;
+            for (; offset + 4 <= count; offset += 4)
+                _mm256_storeu_pd(values + offset, _mm256_sqrt_pd(_mm256_loadu_pd(values + offset)));
+            for (; offset < count; ++offset) values[offset] = PrimitiveSqrtOperation<double>::compute(values[offset]);
+        }
+
+        static void sqrtSse2(double* const values, size_t const count) {
+            size_t offset = 0;
+            for (; offset + 2 <= count; offset += 2)
+                _mm_storeu_pd(values + offset, _mm_sqrt_pd(_mm_loadu_pd(values + offset)));
+            for (; offset < count; ++offset) values[offset] = PrimitiveSqrtOperation<double>::compute(values[offset]);
+        }
+
+#undef CALCULATOR_SIMD_INLINE
+#endif
+
+        template<typename O, typename S>
+        static void dispatchUnary(double* const values, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            switch (instructionSet()) {
+                case InstructionSet::AVX2: return unaryAvx2<O>(values, count);
+                case InstructionSet::SSE2: return unarySse2<O>(values, count);
+                case InstructionSet::SCALAR: break;
+            }
+#endif
+            scalarUnary<S>(values, count);
+        }
+
+    public:
+        /**
+         * @brief Gets the widest instruction set supported by the current processor.
+         */
+        static InstructionSet supportedInstructionSet() noexcept {
+            static InstructionSet const instructionSet = detectInstructionSet();
+            return instructionSet;
+        }
+
+        /**
+         * @brief Gets the instruction set used by the kernels.
+         */
+        static InstructionSet instructionSet() noexcept {
+            return selectedInstructionSet().load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Restricts the instruction set used by the kernels, e.g. to compare them with the scalar ones.
+         *
+         * @param instructionSet instruction set to use which is limited by the supported one
+         */
+        static void useInstructionSet(InstructionSet const instructionSet) noexcept {
+            selectedInstructionSet().store(std::min(instructionSet, supportedInstructionSet()),
+                                           std::memory_order_relaxed);
+        }
+
+        static void sin(double* const values, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            dispatchUnary<Sin, SinOperation<double>>(values, count);
+#else
+            scalarUnary<SinOperation<double>>(values, count);
+#endif
+        }
+
+        static void cos(double* const values, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            dispatchUnary<Cos, CosOperation<double>>(values, count);
+#else
+            scalarUnary<CosOperation<double>>(values, count);
+#endif
+        }
+
+        static void tg(double* const values, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            dispatchUnary<Tg, TgOperation<double>>(values, count);
+#else
+            scalarUnary<TgOperation<double>>(values, count);
+#endif
+        }
+
+        static void ctg(double* const values, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            dispatchUnary<Ctg, CtgOperation<double>>(values, count);
+#else
+            scalarUnary<CtgOperation<double>>(values, count);
+#endif
+        }
+
+        static void sqrt(double* const values, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            switch (instructionSet()) {
+                case InstructionSet::AVX2: return sqrtAvx2(values, count);
+                case InstructionSet::SSE2: return sqrtSse2(values, count);
+                case InstructionSet::SCALAR: break;
+            }
+#endif
+            scalarUnary<PrimitiveSqrtOperation<double>>(values, count);
+        }
+
+        static void pow(double* const left, double const* const right, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            switch (instructionSet()) {
+                case InstructionSet::AVX2: return binaryAvx2<Pow>(left, right, count);
+                case InstructionSet::SSE2: return binarySse2<Pow>(left, right, count);
+                case InstructionSet::SCALAR: break;
+            }
+#endif
+            scalarBinary<PowOperation<double>>(left, right, count);
+        }
+
+        /**
+         * @brief Divides the values without checking the divisors which is left to the caller.
+         */
+        static void divide(double* const left, double const* const right, size_t const count) {
+#ifdef CALCULATOR_SIMD_X86
+            switch (instructionSet()) {
+                case InstructionSet::AVX2: return divideAvx2(left, right, count);
+                case InstructionSet::SSE2: return divideSse2(left, right, count);
+                case InstructionSet::SCALAR: break;
+            }
+#endif
+            for (size_t i = 0; i < count; ++i) left[i] = left[i] / right[i];
+        }
+    };
+} // namespace calculator
+
+#endif //INCLUDE_DOUBLE_KERNELS_H_
@@ -0,0 +1,4 @@
+// replaces the global `operator new` of the profiling build so that `--profile` shows the allocations of each node
+#define CALCULATOR_COUNT_ALLOCATIONS
+
+#include <profiling/allocation_counter.h>
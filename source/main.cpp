@@ -1,7 +1,16 @@
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <system_error>
 
+#include <batch/batch_calculator.h>
+#include <batch/mapped_file.h>
 #include <boost/multiprecision/cpp_int.hpp>
-#include <parser/simple_expression_parser.h>
+#include <parser/caching_expression_parser.h>
+#include <parser/linear_expression_parser.h>
+#include <parser/optimizing_expression_parser.h>
+#include <parser/tiering_expression_parser.h>
+#include <profiling/evaluation_profiler.h>
 
 using BigDecimal = boost::multiprecision::cpp_rational;
 
@@ -9,8 +18,21 @@ static const size_t MAX_VARIABLES = 10;
 
 Variables<BigDecimal> readVariables();
 
-int main() { // x^2 + cos 3.1415926536
-    calculator::SimpleOperationParser<BigDecimal> parser;
+int calculateBatch(char const* file, bool inDoubles);
+
+// usage: [--profile | --batch [--double] [file]]
+int main(int const argc, char** const argv) { // x^2 + cos 3.1415926536
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        auto const inDoubles = argc > 2 && std::strcmp(argv[2], "--double") == 0;
+        auto const fileIndex = inDoubles ? 3 : 2;
+        return calculateBatch(argc > fileIndex ? argv[fileIndex] : nullptr, inDoubles);
+    }
+    auto const profiling = argc > 1 && std::strcmp(argv[1], "--profile") == 0;
+
+    calculator::CachingExpressionParser<BigDecimal> parser(
+            std::make_shared<calculator::TieringExpressionParser<BigDecimal>>(
+                    std::make_shared<calculator::OptimizingExpressionParser<BigDecimal>>(
+                            std::make_shared<calculator::LinearExpressionParser<BigDecimal>>())));
 
     std::string input;
     do {
@@ -18,10 +40,20 @@ int main() { // x^2 + cos 3.1415926536
         try {
             std::cout << "Enter the expression to calculate" << std::endl;
             std::cin.ignore();
-            auto const parsed = parser.parse(std::cin);
+            auto const parsed = parser.parse(std::cin); // the tiered program is cached with the operation
+            auto const& tiered = static_cast<calculator::TieredOperation<BigDecimal> const&>(*parsed);
             try {
-                auto const result = parsed->result(variables);
-                std::cout << "\t=\t" << result << std::endl;
+                if (profiling) {
+                    auto const profiled = calculator::profile(tiered.source());
+                    std::cout << "\t=\t" << profiled.operation->result(variables) << std::endl;
+                    profiled.profile->writeTree(std::cout);
+                    if (!calculator::AllocationCounter::counting())
+                        std::cout << "(allocations are not counted, the `_profile` build counts them)" << std::endl;
+                } else {
+                    auto const result = tiered.tieredResult(variables);
+                    std::cout << "\t=\t" << result.value << "\t(" << calculator::tierName(result.tier) << ')'
+                              << std::endl;
+                }
             } catch (calculator::OperationError const& e) {
                 std::cerr << "Operation error: " << e.what() << std::endl;
             }
@@ -45,12 +77,33 @@ Variables<BigDecimal> readVariables() {
     for (size_t i = 0; i < count; ++i) {
         char name;
         BigDecimal value;
-        do {
+        while (true) {
             std::cout << "Enter the name of the variable and its value" << std::endl;
             std::cin >> name >> value;
-        } while (variables.contains(name));
+            if (!Variables<BigDecimal>::isName(name)) std::cerr << "The name should be a latin letter" << std::endl;
+            else if (!variables.contains(name)) break;
+        }
         variables.insert(std::pair<char, BigDecimal>(name, value));
     }
 
     return Variables(variables);
 }
+
+template<typename T>
+void calculateBatch(char const* const file) {
+    calculator::BatchCalculator<T> batchCalculator;
+    if (file) batchCalculator.calculate(calculator::MappedFile(file).content(), stdout);
+    else batchCalculator.calculate(stdin, stdout);
+}
+
+int calculateBatch(char const* const file, bool const inDoubles) {
+    try {
+        if (inDoubles) calculateBatch<double>(file);
+        else calculateBatch<BigDecimal>(file);
+    } catch (std::system_error const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
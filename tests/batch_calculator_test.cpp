@@ -0,0 +1,20 @@
+#include <batch/batch_calculator.h>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+    using BigDecimal = boost::multiprecision::cpp_rational;
+
+    TEST(BatchCalculatorTest, NegativeAndExpressionValuesAreBound) {
+        calculator::BatchCalculator<BigDecimal> calculator;
+        calculator.calculateAll("x * y;x=-3;y=2\nx;x=-1/3\nx + 1;x=-0,5\n");
+        EXPECT_EQ(calculator.output(), "-6\n-1/3\n1/2\n");
+    }
+
+    TEST(BatchCalculatorTest, NegativeValuesAreBoundInDoubles) {
+        calculator::BatchCalculator<double> calculator;
+        calculator.calculateAll("x * y;x=-3;y=2\n");
+        EXPECT_EQ(calculator.output(), "-6\n");
+    }
+} // namespace
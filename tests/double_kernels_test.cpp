@@ -0,0 +1,138 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include <operation/algebraic_operations.h>
+#include <random>
+#include <simd/double_kernels.h>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    using calculator::InstructionSet;
+    using calculator::SimdDoubleKernels;
+
+    // not a multiple of the widths of the vectors so that the last pack is partial
+    constexpr size_t VALUES = 4099;
+
+    constexpr double INF = std::numeric_limits<double>::infinity(),
+                     NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+    // arguments for which the kernels fall back to the scalar operations
+    std::vector<double> const TRIGONOMETRY_FALLBACKS = {1e5, -1e5, 1e6, -1e300, INF, -INF, NOT_A_NUMBER, 0., -0.};
+
+    std::vector<double> uniform(double const min, double const max) {
+        std::mt19937_64 random(42);
+        std::vector<double> values(VALUES);
+        for (auto& value : values) value = std::uniform_real_distribution(min, max)(random);
+
+        return values;
+    }
+
+    uint64_t ulps(double const left, double const right) {
+        if (std::isnan(left) || std::isnan(right)) return std::isnan(left) && std::isnan(right) ? 0 : UINT64_MAX;
+
+        // the order of the bits of doubles made monotonic
+        auto const ordered = [](double const value) {
+            int64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits < 0 ? INT64_MIN - bits : bits;
+        };
+        auto const difference = ordered(left) - ordered(right);
+
+        return difference < 0 ? 0 - uint64_t(difference) : uint64_t(difference);
+    }
+
+    // runs the tests with every instruction set supported by the processor
+    class DoubleKernelsTest : public testing::TestWithParam<InstructionSet> {
+    protected:
+        void SetUp() override {
+            if (GetParam() > SimdDoubleKernels::supportedInstructionSet()) GTEST_SKIP() << "not supported";
+            SimdDoubleKernels::useInstructionSet(GetParam());
+        }
+
+        void TearDown() override { SimdDoubleKernels::useInstructionSet(SimdDoubleKernels::supportedInstructionSet()); }
+
+        template<typename O, typename K>
+        static void expectUnary(K const kernel, std::vector<double> values, uint64_t const maxUlps) {
+            auto const arguments = values;
+            kernel(values.data(), values.size());
+            for (size_t i = 0; i < values.size(); ++i)
+                EXPECT_LE(ulps(values[i], O::compute(arguments[i])), maxUlps) << "argument " << arguments[i];
+        }
+
+        template<typename O, typename K>
+        static void expectBinary(K const kernel, std::vector<double> left, std::vector<double> const& right,
+                                 uint64_t const maxUlps) {
+            auto const arguments = left;
+            kernel(left.data(), right.data(), left.size());
+            for (size_t i = 0; i < left.size(); ++i)
+                EXPECT_LE(ulps(left[i], O::compute(arguments[i], right[i])), maxUlps)
+                        << "arguments " << arguments[i] << ", " << right[i];
+        }
+
+        // random arguments with the fallback ones spread over the lanes
+        static std::vector<double> trigonometryArguments() {
+            auto values = uniform(-10., 10.);
+            for (size_t i = 0; i < TRIGONOMETRY_FALLBACKS.size(); ++i) values[i * 3] = TRIGONOMETRY_FALLBACKS[i];
+            values.insert(values.end(), TRIGONOMETRY_FALLBACKS.begin(), TRIGONOMETRY_FALLBACKS.end());
+
+            return values;
+        }
+    };
+
+    TEST_P(DoubleKernelsTest, SinIsWithinOneUlp) {
+        expectUnary<calculator::SinOperation<double>>(SimdDoubleKernels::sin, trigonometryArguments(), 1);
+    }
+
+    TEST_P(DoubleKernelsTest, CosIsWithinOneUlp) {
+        expectUnary<calculator::CosOperation<double>>(SimdDoubleKernels::cos, trigonometryArguments(), 1);
+    }
+
+    TEST_P(DoubleKernelsTest, TgIsWithinThreeUlps) {
+        expectUnary<calculator::TgOperation<double>>(SimdDoubleKernels::tg, trigonometryArguments(), 3);
+    }
+
+    TEST_P(DoubleKernelsTest, CtgIsWithinThreeUlps) {
+        expectUnary<calculator::CtgOperation<double>>(SimdDoubleKernels::ctg, trigonometryArguments(), 3);
+    }
+
+    TEST_P(DoubleKernelsTest, SqrtIsExact) {
+        auto values = uniform(0., 1e6);
+        values.insert(values.end(), {0., -0., 1e-310, 1e300, INF, -1., NOT_A_NUMBER});
+        expectUnary<calculator::PrimitiveSqrtOperation<double>>(SimdDoubleKernels::sqrt, values, 0);
+    }
+
+    TEST_P(DoubleKernelsTest, PowIsWithinTwoUlps) {
+        auto left = uniform(1e-3, 1e2), right = uniform(-4., 4.);
+        // negative, zero, subnormal, huge and non-finite bases, large, integral and non-finite exponents
+        std::vector<std::pair<double, double>> const fallbacks = {
+                {-2., .5}, {-2., -1.5}, {-8., 3.},  {0., -1.5}, {-0., 3.}, {1e-310, .5}, {1e300, 4.},
+                {INF, .5}, {-INF, 3.},  {2., 100.}, {1e2, -200.}, {M_E, 1.5}, {7., 2.},  {7., 0.},
+                {7., 1.},  {1., INF},   {NOT_A_NUMBER, .5}, {.5, NOT_A_NUMBER}};
+        for (size_t i = 0; i < fallbacks.size(); ++i) std::tie(left[i * 3], right[i * 3]) = fallbacks[i];
+        for (auto const& [base, exponent] : fallbacks) {
+            left.push_back(base);
+            right.push_back(exponent);
+        }
+
+        expectBinary<calculator::PowOperation<double>>(SimdDoubleKernels::pow, left, right, 2);
+    }
+
+    TEST_P(DoubleKernelsTest, DivideIsExact) {
+        auto left = uniform(-1e3, 1e3), right = uniform(1., 1e3);
+        left.insert(left.end(), {1., -1., 0., INF, NOT_A_NUMBER, 1e300});
+        right.insert(right.end(), {0., -0., 0., INF, 1., 1e-300});
+
+        auto const arguments = left;
+        SimdDoubleKernels::divide(left.data(), right.data(), left.size());
+        for (size_t i = 0; i < left.size(); ++i)
+            EXPECT_EQ(ulps(left[i], arguments[i] / right[i]), 0) << "arguments " << arguments[i] << ", " << right[i];
+    }
+
+    INSTANTIATE_TEST_SUITE_P(InstructionSets, DoubleKernelsTest,
+                             testing::Values(InstructionSet::SCALAR, InstructionSet::SSE2, InstructionSet::AVX2));
+} // namespace
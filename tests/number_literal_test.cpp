@@ -0,0 +1,42 @@
+#include <boost/multiprecision/cpp_int.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <parser/linear_expression_parser.h>
+#include <parser/number_literal.h>
+#include <string>
+
+namespace {
+
+    using BigDecimal = boost::multiprecision::cpp_rational;
+
+    TEST(NumberLiteralTest, SignedLiteralsAreLiterals) {
+        EXPECT_TRUE(calculator::isNumberLiteral("3"));
+        EXPECT_TRUE(calculator::isNumberLiteral("-3"));
+        EXPECT_TRUE(calculator::isNumberLiteral("-0,25"));
+        EXPECT_FALSE(calculator::isNumberLiteral("-"));
+        EXPECT_FALSE(calculator::isNumberLiteral("--3"));
+        EXPECT_FALSE(calculator::isNumberLiteral("3-"));
+        EXPECT_FALSE(calculator::isNumberLiteral("1/3"));
+    }
+
+    TEST(NumberLiteralTest, NegativeLiteralsAreParsed) {
+        EXPECT_EQ(calculator::parseNumberLiteral<double>("-3"), -3.);
+        EXPECT_EQ(calculator::parseNumberLiteral<double>("-0,25"), -0.25);
+        EXPECT_EQ(calculator::parseNumberLiteral<BigDecimal>("-3"), -3);
+        EXPECT_EQ(calculator::parseNumberLiteral<BigDecimal>("-0,25"), BigDecimal(-1, 4));
+    }
+
+    TEST(NumberLiteralTest, OutOfRangeDoubleLiteralsAreRoundedAsByStrtod) {
+        auto const huge = "1" + std::string(400, '0'), tiny = "0," + std::string(400, '0') + "1";
+        EXPECT_EQ(calculator::parseNumberLiteral<double>(huge), std::numeric_limits<double>::infinity());
+        EXPECT_EQ(calculator::parseNumberLiteral<double>('-' + huge), -std::numeric_limits<double>::infinity());
+        EXPECT_EQ(calculator::parseNumberLiteral<double>(tiny), 0.);
+        EXPECT_EQ(calculator::parseNumberLiteral<double>("0," + std::string(315, '0') + "1"), 1e-316);
+    }
+
+    TEST(NumberLiteralTest, OutOfRangeDoubleLiteralOfExpressionIsInfinite) {
+        auto const operation =
+                calculator::LinearExpressionParser<double>().parse("2 * 1" + std::string(400, '0'));
+        EXPECT_EQ(operation->result({}), std::numeric_limits<double>::infinity());
+    }
+} // namespace
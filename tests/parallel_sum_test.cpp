@@ -0,0 +1,71 @@
+#include <boost/multiprecision/cpp_int.hpp>
+#include <bytecode/tiered_operation.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <parser/linear_expression_parser.h>
+#include <parser/parallelizing_expression_parser.h>
+#include <string>
+
+namespace {
+
+    using BigDecimal = boost::multiprecision::cpp_rational;
+
+    // `x / 1 + x / 2 + ...` with the given number of operands
+    std::string wideSum(size_t const operands) {
+        std::string expression = "x / 1";
+        for (size_t i = 2; i <= operands; ++i) expression += " + x / " + std::to_string(i);
+
+        return expression;
+    }
+
+    class ParallelSumTest : public testing::Test {
+        size_t const threshold_ = calculator::VectorSumOperation<BigDecimal>::pairwiseThreshold();
+        size_t const doubleThreshold_ = calculator::VectorSumOperation<double>::pairwiseThreshold();
+
+    protected:
+        void SetUp() override {
+            calculator::VectorSumOperation<BigDecimal>::setPairwiseThreshold(8);
+            calculator::VectorSumOperation<double>::setPairwiseThreshold(8);
+        }
+
+        void TearDown() override {
+            calculator::VectorSumOperation<BigDecimal>::setPairwiseThreshold(threshold_);
+            calculator::VectorSumOperation<double>::setPairwiseThreshold(doubleThreshold_);
+        }
+    };
+
+    TEST_F(ParallelSumTest, WideSumsAreParallelized) {
+        auto const operation = calculator::LinearExpressionParser<BigDecimal>().parse(std::string_view(wideSum(40)));
+        calculator::OperationParallelizer<BigDecimal> parallelizer;
+        parallelizer.transform(operation);
+        EXPECT_EQ(parallelizer.parallelized(), 1);
+
+        auto const narrow = calculator::LinearExpressionParser<BigDecimal>().parse(std::string_view(wideSum(4)));
+        calculator::OperationParallelizer<BigDecimal> narrowParallelizer;
+        narrowParallelizer.transform(narrow);
+        EXPECT_EQ(narrowParallelizer.parallelized(), 0);
+    }
+
+    TEST_F(ParallelSumTest, ExactTierOfWideSumIsParallel) {
+        auto const source = calculator::LinearExpressionParser<BigDecimal>().parse(std::string_view(wideSum(40)));
+        calculator::TieredOperation<BigDecimal> const tiered(source);
+        Variables<BigDecimal> variables;
+        variables.set('x', BigDecimal(1, 3));
+
+        auto const result = tiered.tieredResult(variables);
+        EXPECT_EQ(result.value, source->result(variables));
+        EXPECT_EQ(result.tier, calculator::Tier::EXACT);
+    }
+
+    TEST_F(ParallelSumTest, ParallelizedDoubleSumIsTheSame) {
+        auto const expression = wideSum(40);
+        auto const source = calculator::LinearExpressionParser<double>().parse(std::string_view(expression));
+        auto const parallel = calculator::ParallelizingExpressionParser<double>(
+                                      std::make_shared<calculator::LinearExpressionParser<double>>())
+                                      .parse(std::string_view(expression));
+        Variables<double> variables;
+        variables.set('x', 0.1);
+
+        EXPECT_EQ(parallel->result(variables), source->result(variables));
+    }
+} // namespace
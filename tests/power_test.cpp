@@ -0,0 +1,47 @@
+#include <boost/multiprecision/cpp_int.hpp>
+#include <bytecode/tiered_program.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <parser/linear_expression_parser.h>
+#include <parser/optimizing_expression_parser.h>
+
+namespace {
+
+    using BigDecimal = boost::multiprecision::cpp_rational;
+
+    calculator::TieredResult<BigDecimal> tiered(char const* const expression, BigDecimal const& x) {
+        auto const operation = calculator::LinearExpressionParser<BigDecimal>().parse(std::string_view(expression));
+        Variables<BigDecimal> variables;
+        variables.set('x', x);
+
+        return calculator::compileTiered(*operation).result(variables);
+    }
+
+    TEST(PowerTest, ZeroPowerOfIntegerIsComputedByIntegerTier) {
+        auto const result = tiered("x^0", 3);
+        EXPECT_EQ(result.value, 1);
+        EXPECT_EQ(result.tier, calculator::Tier::INTEGER);
+    }
+
+    TEST(PowerTest, ZeroPowerOfRationalIsComputedByExactTier) {
+        auto const result = tiered("x^0", BigDecimal(1, 2));
+        EXPECT_EQ(result.value, 1);
+        EXPECT_EQ(result.tier, calculator::Tier::EXACT);
+    }
+
+    TEST(PowerTest, ZeroPowerOfRationalIsComputedByOperation) {
+        EXPECT_EQ(calculator::PowOperation<BigDecimal>::compute(BigDecimal(1, 3), int64_t(0)), 1);
+        EXPECT_EQ(calculator::PowOperation<BigDecimal>::compute(BigDecimal(-7, 5), int64_t(0)), 1);
+    }
+
+    TEST(PowerTest, ZeroPowerOfRationalConstantIsFolded) {
+        calculator::OptimizingExpressionParser<BigDecimal> parser(
+                std::make_shared<calculator::LinearExpressionParser<BigDecimal>>());
+        EXPECT_EQ(parser.parse(std::string_view("(1/3)^0"))->result({}), 1);
+    }
+
+    TEST(PowerTest, HugePowerIsRejected) {
+        EXPECT_THROW(calculator::PowOperation<BigDecimal>::compute(BigDecimal(2), int64_t(1) << 40),
+                     calculator::OperationError);
+    }
+} // namespace